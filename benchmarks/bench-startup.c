@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3-or-later
+ */
+
+/*
+ * Measure the startup path: device database registration → device
+ * tree compatibles → device info → display panel.
+ *
+ * Every case is measured once "cold" (first call in a fresh process)
+ * and then "warm" for a number of iterations. The results are printed
+ * as a single JSON object on stdout.
+ */
+
+#define GMOBILE_USE_UNSTABLE_API
+#include "gmobile.h"
+
+#include "gm-device-db-private.h"
+
+#include <glib/gprintf.h>
+
+#include <sys/resource.h>
+#include <time.h>
+
+/*
+ * Count allocations by interposing the allocator. This catches GLib's
+ * allocations too as the executable's symbols take precedence. Not
+ * possible when the address sanitizer already does the same.
+ */
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+# define COUNT_ALLOCS 1
+
+extern void *__libc_malloc (size_t size);
+extern void *__libc_calloc (size_t nmemb, size_t size);
+extern void *__libc_realloc (void *ptr, size_t size);
+
+static gint64 n_allocs, n_alloc_bytes;
+
+static inline void
+count_alloc (size_t size)
+{
+  __atomic_fetch_add (&n_allocs, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add (&n_alloc_bytes, size, __ATOMIC_RELAXED);
+}
+
+void *
+malloc (size_t size)
+{
+  count_alloc (size);
+  return __libc_malloc (size);
+}
+
+void *
+calloc (size_t nmemb, size_t size)
+{
+  count_alloc (nmemb * size);
+  return __libc_calloc (nmemb, size);
+}
+
+void *
+realloc (void *ptr, size_t size)
+{
+  count_alloc (size);
+  return __libc_realloc (ptr, size);
+}
+#else
+# define COUNT_ALLOCS 0
+
+static gint64 n_allocs = -1, n_alloc_bytes = -1;
+#endif
+
+typedef void (*BenchFunc) (gpointer data);
+
+typedef struct {
+  const char *sysfs_root;
+  GStrv       compatibles;
+  GStrv       devices;
+} BenchData;
+
+typedef struct {
+  gint64 wall_ns;
+  gint64 allocs;
+  gint64 alloc_bytes;
+} BenchSample;
+
+
+static gint64
+now_ns (void)
+{
+  struct timespec ts;
+
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return (gint64)ts.tv_sec * G_GINT64_CONSTANT (1000000000) + ts.tv_nsec;
+}
+
+
+static long
+peak_rss_kib (void)
+{
+  struct rusage usage;
+
+  if (getrusage (RUSAGE_SELF, &usage) != 0)
+    return -1;
+
+  return usage.ru_maxrss;
+}
+
+
+static void
+run_once (BenchFunc func, gpointer data, BenchSample *sample)
+{
+  gint64 allocs = n_allocs;
+  gint64 alloc_bytes = n_alloc_bytes;
+  gint64 start = now_ns ();
+
+  func (data);
+
+  sample->wall_ns = now_ns () - start;
+  sample->allocs = COUNT_ALLOCS ? n_allocs - allocs : -1;
+  sample->alloc_bytes = COUNT_ALLOCS ? n_alloc_bytes - alloc_bytes : -1;
+}
+
+
+static void
+bench_device_db (gpointer data)
+{
+  gm_device_db_get_resource ();
+}
+
+
+static void
+bench_compatibles (gpointer data)
+{
+  BenchData *bench = data;
+  g_autoptr (GError) err = NULL;
+  g_auto (GStrv) compatibles = NULL;
+
+  compatibles = gm_device_tree_get_compatibles (bench->sysfs_root, &err);
+  if (compatibles == NULL)
+    g_error ("Failed to get compatibles: %s", err->message);
+}
+
+
+static void
+bench_device_info (gpointer data)
+{
+  BenchData *bench = data;
+  g_autoptr (GmDeviceInfo) info = NULL;
+
+  info = gm_device_info_new ((const char * const *)bench->compatibles);
+  if (gm_device_info_get_display_panel (info) == NULL)
+    g_error ("No panel for %s", bench->compatibles[0]);
+}
+
+
+static void
+bench_panels (gpointer data)
+{
+  BenchData *bench = data;
+
+  for (int i = 0; bench->devices[i]; i++) {
+    g_autofree char *resource = NULL;
+    g_autoptr (GmDisplayPanel) panel = NULL;
+    g_autoptr (GError) err = NULL;
+
+    resource = g_strdup_printf ("/mobi/phosh/gmobile/devices/display-panels/%s.json",
+                                bench->devices[i]);
+    panel = gm_display_panel_new_from_resource (resource, &err);
+    if (panel == NULL)
+      g_error ("Failed to load %s: %s", resource, err->message);
+  }
+}
+
+
+static int
+compare_gint64 (gconstpointer a, gconstpointer b)
+{
+  gint64 x = *(const gint64 *)a, y = *(const gint64 *)b;
+
+  return (x > y) - (x < y);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_autoptr (GOptionContext) opt_context = NULL;
+  g_autoptr (GError) err = NULL;
+  g_autofree char *bench_case = NULL;
+  g_autofree char *sysfs_root = NULL;
+  g_autofree gint64 *warm_ns = NULL;
+  int iterations = 100;
+  BenchData bench = { 0 };
+  BenchSample cold, warm;
+  BenchFunc func;
+  gint64 warm_total_ns = 0, warm_allocs = 0, warm_alloc_bytes = 0;
+
+  const GOptionEntry options [] = {
+    {"case", 'c', 0, G_OPTION_ARG_STRING, &bench_case,
+     "Case to run (device-db, compatibles, device-info, panels)", NULL},
+    {"sysfs-root", 's', 0, G_OPTION_ARG_FILENAME, &sysfs_root,
+     "Where sysfs is mounted", NULL},
+    {"iterations", 'i', 0, G_OPTION_ARG_INT, &iterations,
+     "Number of warm iterations", NULL},
+    { NULL, 0, 0, G_OPTION_ARG_NONE, NULL, NULL, NULL }
+  };
+
+  opt_context = g_option_context_new ("- measure gmobile startup cost");
+  g_option_context_add_main_entries (opt_context, options, NULL);
+  if (!g_option_context_parse (opt_context, &argc, &argv, &err)) {
+    g_printerr ("%s\n", err->message);
+    return EXIT_FAILURE;
+  }
+
+  if (bench_case == NULL || iterations < 1) {
+    g_printerr ("Need a case and at least one iteration\n");
+    return EXIT_FAILURE;
+  }
+
+  /* Make sure we measure the real thing */
+  g_unsetenv ("GMOBILE_DT_COMPATIBLES");
+  bench.sysfs_root = sysfs_root;
+
+  /* Set up everything the case doesn't measure */
+  if (g_str_equal (bench_case, "device-db")) {
+    func = bench_device_db;
+  } else if (g_str_equal (bench_case, "compatibles")) {
+    func = bench_compatibles;
+  } else if (g_str_equal (bench_case, "device-info")) {
+    gm_device_db_get_resource ();
+    bench.compatibles = gm_device_tree_get_compatibles (sysfs_root, &err);
+    if (bench.compatibles == NULL) {
+      g_printerr ("Failed to get compatibles: %s\n", err->message);
+      return EXIT_FAILURE;
+    }
+    func = bench_device_info;
+  } else if (g_str_equal (bench_case, "panels")) {
+    bench.devices = gm_list_devices ();
+    func = bench_panels;
+  } else {
+    g_printerr ("Unknown case '%s'\n", bench_case);
+    return EXIT_FAILURE;
+  }
+
+  run_once (func, &bench, &cold);
+
+  warm_ns = g_new (gint64, iterations);
+  for (int i = 0; i < iterations; i++) {
+    run_once (func, &bench, &warm);
+    warm_ns[i] = warm.wall_ns;
+    warm_total_ns += warm.wall_ns;
+    warm_allocs += warm.allocs;
+    warm_alloc_bytes += warm.alloc_bytes;
+  }
+  qsort (warm_ns, iterations, sizeof (gint64), compare_gint64);
+
+  /* Allocation numbers are -1 when they can't be counted */
+  if (COUNT_ALLOCS) {
+    warm_allocs /= iterations;
+    warm_alloc_bytes /= iterations;
+  } else {
+    warm_allocs = warm_alloc_bytes = -1;
+  }
+
+  g_printf ("{\"case\": \"%s\", "
+            "\"cold\": {\"wall_ns\": %" G_GINT64_FORMAT ", "
+            "\"allocs\": %" G_GINT64_FORMAT ", \"alloc_bytes\": %" G_GINT64_FORMAT "}, "
+            "\"warm\": {\"iterations\": %d, \"wall_ns_min\": %" G_GINT64_FORMAT ", "
+            "\"wall_ns_median\": %" G_GINT64_FORMAT ", \"wall_ns_mean\": %" G_GINT64_FORMAT ", "
+            "\"allocs_mean\": %" G_GINT64_FORMAT ", \"alloc_bytes_mean\": %" G_GINT64_FORMAT "}, "
+            "\"peak_rss_kib\": %ld}\n",
+            bench_case,
+            cold.wall_ns, cold.allocs, cold.alloc_bytes,
+            iterations, warm_ns[0], warm_ns[iterations / 2], warm_total_ns / iterations,
+            warm_allocs, warm_alloc_bytes,
+            peak_rss_kib ());
+
+  g_strfreev (bench.compatibles);
+  g_strfreev (bench.devices);
+
+  return EXIT_SUCCESS;
+}
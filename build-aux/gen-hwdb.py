@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2026 The Phosh Developers
+#
+# SPDX-License-Identifier: LGPL-2.1-or-later
+#
+# Compile hwdb files into a trie over the literal prefixes of their
+# match patterns. The rest of a pattern, starting at its first glob
+# character, is attached to the node the prefix ends in and matched
+# with fnmatch() at lookup time like systemd-hwdb does.
+
+import argparse
+import os
+import sys
+
+GLOB_CHARS = "*?["
+
+
+class Node:
+    def __init__(self, c):
+        self.c = c
+        self.children = {}
+        self.matches = []
+
+
+def parse(paths):
+    # A list of (patterns, properties) in file and line order
+    records = []
+
+    # Later files override earlier ones like in systemd-hwdb
+    for path in sorted(paths, key=os.path.basename):
+        patterns = []
+        properties = []
+        with open(path, encoding="utf-8") as f:
+            for lineno, line in enumerate(f, 1):
+                line = line.rstrip("\n")
+                if line.startswith("#"):
+                    continue
+                if not line.strip():
+                    if properties:
+                        records.append((patterns, properties))
+                    elif patterns:
+                        sys.exit(f"{path}:{lineno}: Match without properties")
+                    patterns, properties = [], []
+                    continue
+
+                if not line[0].isspace():
+                    if properties:
+                        sys.exit(f"{path}:{lineno}: Match after properties, missing empty line?")
+                    patterns.append(line)
+                    continue
+
+                if not patterns:
+                    sys.exit(f"{path}:{lineno}: Property without match")
+                name, sep, value = line.strip().partition("=")
+                if not sep or not name:
+                    sys.exit(f"{path}:{lineno}: Expected '<name>=<value>'")
+                properties.append((name, value))
+
+        if properties:
+            records.append((patterns, properties))
+        elif patterns:
+            sys.exit(f"{path}: Match without properties at end of file")
+
+    return records
+
+
+def build_trie(records):
+    root = Node("\0")
+
+    for index, (patterns, _) in enumerate(records):
+        for pattern in patterns:
+            split = min((pattern.find(c) for c in GLOB_CHARS if c in pattern),
+                        default=len(pattern))
+            node = root
+            for c in pattern[:split]:
+                node = node.children.setdefault(c, Node(c))
+            node.matches.append((pattern[split:], index))
+
+    return root
+
+
+def flatten(root):
+    # Breadth first so siblings are adjacent
+    nodes = [root]
+    index = {id(root): 0}
+    i = 0
+    while i < len(nodes):
+        for c in sorted(nodes[i].children):
+            child = nodes[i].children[c]
+            index[id(child)] = len(nodes)
+            nodes.append(child)
+        i += 1
+
+    if len(nodes) > 0xffff:
+        sys.exit("Too many trie nodes")
+
+    rows = []
+    matches = []
+    for node in nodes:
+        children = [node.children[c] for c in sorted(node.children)]
+        first = index[id(children[0])] if children else 0
+        rows.append((node.c, first, len(children), len(matches), len(node.matches)))
+        matches += node.matches
+    return rows, matches
+
+
+def c_char(c):
+    if c == "\0":
+        return "'\\0'"
+    if c in "'\\":
+        return f"'\\{c}'"
+    return f"'{c}'"
+
+
+def c_string(s):
+    return '"' + s.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--output", required=True)
+    parser.add_argument("inputs", nargs="+")
+    args = parser.parse_args()
+
+    records = parse(args.inputs)
+    rows, matches = flatten(build_trie(records))
+
+    with open(args.output, "w", encoding="utf-8") as out:
+        names = ", ".join(os.path.basename(path) for path in sorted(args.inputs))
+        out.write(f"/* Generated from {names}, do not edit */\n\n")
+
+        out.write("static const GmHwdbNode hwdb_nodes[] = {\n")
+        for c, first, n_children, first_match, n_matches in rows:
+            out.write(f"  {{ {c_char(c)}, {first}, {n_children}, {first_match}, {n_matches} }},\n")
+        out.write("};\n\n")
+
+        out.write("static const GmHwdbMatch hwdb_matches[] = {\n")
+        for glob, record in matches:
+            out.write(f"  {{ {c_string(glob)}, {record} }},\n")
+        out.write("};\n\n")
+
+        n_properties = 0
+        out.write("static const GmHwdbRecord hwdb_records[] = {\n")
+        for _, properties in records:
+            out.write(f"  {{ {n_properties}, {len(properties)} }},\n")
+            n_properties += len(properties)
+        out.write("};\n\n")
+
+        out.write("static const GmHwdbProperty hwdb_properties[] = {\n")
+        for _, properties in records:
+            for name, value in properties:
+                out.write(f"  {{ {c_string(name)}, {c_string(value)} }},\n")
+        out.write("};\n")
+
+
+if __name__ == "__main__":
+    main()
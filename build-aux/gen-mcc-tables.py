@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2026 The Phosh Developers
+#
+# SPDX-License-Identifier: LGPL-2.1-or-later
+#
+# Generate direct lookup tables from the list of mobile country codes.
+
+import argparse
+import os
+import sys
+
+N_MCC = 1000
+N_ISO_SLOTS = 26 * 26
+
+
+def parse(path):
+    entries = []
+    with open(path, encoding="utf-8") as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            parts = line.split()
+            if len(parts) != 2:
+                sys.exit(f"{path}:{lineno}: Expected '<mcc> <iso>'")
+            mcc, iso = parts
+            if len(mcc) != 3 or not mcc.isdigit():
+                sys.exit(f"{path}:{lineno}: Invalid MCC '{mcc}'")
+            if len(iso) != 2 or not iso.isascii() or not iso.isupper():
+                sys.exit(f"{path}:{lineno}: Invalid ISO 3166-1 code '{iso}'")
+            if (int(mcc), iso) in entries:
+                sys.exit(f"{path}:{lineno}: Duplicate entry '{mcc} {iso}'")
+            entries.append((int(mcc), iso))
+    return entries
+
+
+def write_iso_tables(out, entries):
+    isos = {}
+    for mcc, iso in entries:
+        isos.setdefault(mcc, []).append(iso)
+
+    # Slot 0 is the empty list used for unknown MCCs
+    offsets = {}
+    n = 1
+    for mcc in sorted(isos):
+        offsets[mcc] = n
+        n += len(isos[mcc]) + 1
+    if n > 0xffff:
+        sys.exit("Too many entries")
+
+    out.write("/* The ISO 3166-1 codes of all MCCs, a NULL terminated list per MCC */\n")
+    out.write("static const char * const mcc_isos[] = {\n")
+    out.write("  NULL,\n")
+    for mcc in sorted(isos):
+        codes = ", ".join(f'"{iso}"' for iso in isos[mcc])
+        out.write(f"  /* {mcc} */ {codes}, NULL,\n")
+    out.write("};\n\n")
+
+    out.write("/* The start of each MCC's list in mcc_isos, 0 if the MCC is unknown */\n")
+    out.write(f"static const guint16 mcc_isos_offset[{N_MCC}] = {{\n")
+    for mcc in sorted(isos):
+        out.write(f"  [{mcc}] = {offsets[mcc]},\n")
+    out.write("};\n")
+
+
+def write_country_tables(out, entries):
+    countries = sorted({iso for _, iso in entries})
+    index = {iso: i + 1 for i, iso in enumerate(countries)}
+
+    # An MCC's country is the first listed one like in mcc_isos
+    mcc_country = {}
+    for mcc, iso in entries:
+        mcc_country.setdefault(mcc, index[iso])
+
+    out.write("/* All countries, indexed by country index. Index 0 is unknown */\n")
+    out.write("static const char * const mcc_countries[] = {\n")
+    out.write("  NULL,\n")
+    for iso in countries:
+        out.write(f'  "{iso}",\n')
+    out.write("};\n\n")
+
+    out.write("/* The country index of each MCC, 0 if the MCC is unknown */\n")
+    out.write(f"static const guint16 mcc_country_index[{N_MCC}] = {{\n")
+    for mcc in sorted(mcc_country):
+        out.write(f"  [{mcc}] = {mcc_country[mcc]},\n")
+    out.write("};\n")
+
+
+def write_reverse_tables(out, entries):
+    mccs = {}
+    for mcc, iso in entries:
+        mccs.setdefault(iso, []).append(mcc)
+
+    out.write("/* The MCCs of all countries, sorted by ISO 3166-1 code and MCC */\n")
+    out.write("static const guint16 iso_mccs[] = {\n")
+    for iso in sorted(mccs):
+        values = ", ".join(str(mcc) for mcc in sorted(mccs[iso]))
+        out.write(f"  /* {iso} */ {values},\n")
+    out.write("};\n\n")
+
+    # One slot per possible two letter code plus one so the number of
+    # MCCs of a slot is the difference to the next one's offset
+    offsets = []
+    n = 0
+    for slot in range(N_ISO_SLOTS + 1):
+        offsets.append(n)
+        if slot < N_ISO_SLOTS:
+            iso = chr(ord("A") + slot // 26) + chr(ord("A") + slot % 26)
+            n += len(mccs.get(iso, []))
+
+    out.write("/* The start of each country's MCCs in iso_mccs, indexed by\n")
+    out.write(" * (first letter - 'A') * 26 + (second letter - 'A') */\n")
+    out.write(f"static const guint16 iso_mccs_offset[{N_ISO_SLOTS + 1}] = {{\n")
+    for i in range(0, len(offsets), 13):
+        out.write("  " + ", ".join(str(o) for o in offsets[i:i + 13]) + ",\n")
+    out.write("};\n")
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("input")
+    parser.add_argument("output")
+    args = parser.parse_args()
+
+    entries = parse(args.input)
+
+    with open(args.output, "w", encoding="utf-8") as out:
+        out.write(f"/* Generated from {os.path.basename(args.input)}, do not edit */\n\n")
+        write_iso_tables(out, entries)
+        out.write("\n")
+        write_country_tables(out, entries)
+        out.write("\n")
+        write_reverse_tables(out, entries)
+
+
+if __name__ == "__main__":
+    main()
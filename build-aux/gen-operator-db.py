@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2026 The Phosh Developers
+#
+# SPDX-License-Identifier: LGPL-2.1-or-later
+#
+# Compile mobile-broadband-provider-info's serviceproviders.xml into
+# the memory mappable operator database read by gm-operator-db.c.
+#
+# All integers are little endian. The file consists of:
+#
+#   header:    magic "GMOPDB\0\0", guint32 version, guint32 n_nodes,
+#              guint32 n_operators, guint32 strings_size
+#   nodes:     n_nodes * { guint16 children, guint16 operator, guint32 first_child }
+#   operators: n_operators * { guint32 name, char country[2], guint8 flags, guint8 mnc_len }
+#   strings:   strings_size bytes of NUL terminated UTF-8 strings
+#
+# The nodes form a trie over the digits of MCC and MNC. `children` is
+# a bitmap of the digits that have a child node, the children are stored
+# consecutively in digit order starting at `first_child`. `operator` is
+# the operator's index + 1, 0 if no operator ends at this node. Node 0
+# is the root.
+
+import argparse
+import struct
+import sys
+import xml.etree.ElementTree as ET
+
+MAGIC = b"GMOPDB\0\0"
+VERSION = 1
+
+FLAG_SHARED = 1 << 0
+
+
+class Node:
+    def __init__(self):
+        self.children = {}
+        self.operator = None
+
+
+def parse(path):
+    operators = {}
+
+    try:
+        tree = ET.parse(path)
+    except (OSError, ET.ParseError) as e:
+        sys.exit(f"Failed to parse {path}: {e}")
+
+    for country in tree.getroot().iter("country"):
+        code = country.get("code", "").upper()
+        if len(code) != 2 or not code.isascii() or not code.isalpha():
+            sys.exit(f"Invalid country code '{code}'")
+
+        for provider in country.iter("provider"):
+            name = provider.findtext("name")
+            if not name:
+                continue
+            primary = provider.get("primary", "false") == "true"
+
+            for network in provider.iter("network-id"):
+                mcc = network.get("mcc", "")
+                mnc = network.get("mnc", "")
+                if len(mcc) != 3 or not mcc.isdigit() or len(mnc) not in (2, 3) or not mnc.isdigit():
+                    print(f"Ignoring invalid network id {mcc}/{mnc} of '{name}'", file=sys.stderr)
+                    continue
+
+                key = mcc + mnc
+                entry = operators.get(key)
+                if entry is None:
+                    operators[key] = {"name": name.strip(), "country": code,
+                                      "flags": 0, "primary": primary}
+                    continue
+
+                # Several providers (e.g. MVNOs or brands) share this network
+                if entry["name"] != name.strip():
+                    entry["flags"] |= FLAG_SHARED
+                    if primary and not entry["primary"]:
+                        entry.update(name=name.strip(), country=code, primary=True)
+
+    return operators
+
+
+def build(operators):
+    root = Node()
+    records = []
+    strings = bytearray()
+    string_offsets = {}
+
+    for key in sorted(operators):
+        op = operators[key]
+        name = op["name"].encode("utf-8")
+        if name not in string_offsets:
+            string_offsets[name] = len(strings)
+            strings += name + b"\0"
+
+        records.append((string_offsets[name], op["country"].encode("ascii"),
+                        op["flags"], len(key) - 3))
+
+        node = root
+        for digit in key:
+            node = node.children.setdefault(int(digit), Node())
+        node.operator = len(records)
+
+    # Breadth first so all children of a node are consecutive
+    nodes = [root]
+    i = 0
+    while i < len(nodes):
+        for digit in sorted(nodes[i].children):
+            nodes.append(nodes[i].children[digit])
+        i += 1
+
+    index = {id(node): i for i, node in enumerate(nodes)}
+    if len(records) >= 0xffff:
+        sys.exit("Too many operators")
+
+    out = bytearray()
+    out += MAGIC
+    out += struct.pack("<IIII", VERSION, len(nodes), len(records), len(strings))
+    for node in nodes:
+        bitmap = 0
+        for digit in node.children:
+            bitmap |= 1 << digit
+        first = index[id(node.children[min(node.children)])] if node.children else 0
+        out += struct.pack("<HHI", bitmap, node.operator or 0, first)
+    for name, country, flags, mnc_len in records:
+        out += struct.pack("<I2sBB", name, country, flags, mnc_len)
+    out += strings
+
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("input", help="serviceproviders.xml")
+    parser.add_argument("output")
+    args = parser.parse_args()
+
+    db = build(parse(args.input))
+    with open(args.output, "wb") as f:
+        f.write(db)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2026 The Phosh Developers
+#
+# SPDX-License-Identifier: LGPL-2.1-or-later
+#
+# Compile the display panel patterns into a trie that can be walked
+# in a single pass over a compatible.
+
+import argparse
+import os
+import sys
+
+
+class Node:
+    def __init__(self, c):
+        self.c = c
+        self.children = {}
+        self.prefix_target = -1
+        self.exact_target = -1
+
+
+def parse(path, panels_dir):
+    patterns = []
+    with open(path, encoding="utf-8") as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            parts = line.split()
+            if len(parts) != 2:
+                sys.exit(f"{path}:{lineno}: Expected '<pattern> <panel>'")
+            pattern, target = parts
+            if "*" in pattern[:-1]:
+                sys.exit(f"{path}:{lineno}: '*' is only supported at the end of a pattern")
+            if pattern == "*":
+                sys.exit(f"{path}:{lineno}: Pattern matches everything")
+            if not pattern.isascii():
+                sys.exit(f"{path}:{lineno}: Only ASCII patterns are supported")
+            if panels_dir and not os.path.exists(os.path.join(panels_dir, f"{target}.json")):
+                sys.exit(f"{path}:{lineno}: No panel description for '{target}'")
+            patterns.append((pattern, target))
+    return patterns
+
+
+def build_trie(patterns):
+    root = Node("\0")
+    targets = []
+
+    for pattern, target in patterns:
+        if target not in targets:
+            targets.append(target)
+        index = targets.index(target)
+
+        prefix = pattern.endswith("*")
+        node = root
+        for c in pattern.rstrip("*"):
+            node = node.children.setdefault(c, Node(c))
+
+        if prefix:
+            node.prefix_target = index
+        else:
+            node.exact_target = index
+
+    return root, targets
+
+
+def flatten(root):
+    # Breadth first so siblings are adjacent
+    nodes = [root]
+    index = {id(root): 0}
+    i = 0
+    while i < len(nodes):
+        for c in sorted(nodes[i].children):
+            child = nodes[i].children[c]
+            index[id(child)] = len(nodes)
+            nodes.append(child)
+        i += 1
+
+    if len(nodes) > 0x7fff:
+        sys.exit("Too many trie nodes")
+
+    rows = []
+    for node in nodes:
+        children = [node.children[c] for c in sorted(node.children)]
+        first = index[id(children[0])] if children else 0
+        rows.append((node.c, first, len(children), node.prefix_target, node.exact_target))
+    return rows
+
+
+def c_char(c):
+    if c == "\0":
+        return "'\\0'"
+    if c in "'\\":
+        return f"'\\{c}'"
+    return f"'{c}'"
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--panels-dir", help="Check that panel descriptions exist")
+    parser.add_argument("input")
+    parser.add_argument("output")
+    args = parser.parse_args()
+
+    patterns = parse(args.input, args.panels_dir)
+    root, targets = build_trie(patterns)
+    rows = flatten(root)
+
+    with open(args.output, "w", encoding="utf-8") as out:
+        out.write(f"/* Generated from {os.path.basename(args.input)}, do not edit */\n\n")
+        out.write("static const GmPatternNode pattern_nodes[] = {\n")
+        for c, first, n_children, prefix_target, exact_target in rows:
+            out.write(f"  {{ {c_char(c)}, {first}, {n_children}, {prefix_target}, {exact_target} }},\n")
+        out.write("};\n\n")
+        out.write("static const char * const pattern_targets[] = {\n")
+        for target in targets:
+            out.write(f'  "{target}",\n')
+        out.write("  NULL,\n};\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -9,6 +9,9 @@
 #define GMOBILE_USE_UNSTABLE_API
 #include "gmobile.h"
 
+#include "panel-raster.h"
+#include "panel-svg.h"
+
 #include <gio/gio.h>
 #include <glib/gprintf.h>
 
@@ -19,85 +22,13 @@ print_version (void)
   exit (0);
 }
 
-#define X_OFF 5
-#define Y_OFF 5
-
-static char *
-build_svg (GmDisplayPanel *panel)
-{
-  GString *svg = g_string_new ("");
-  int xres = gm_display_panel_get_x_res (panel);
-  int yres = gm_display_panel_get_y_res (panel);
-  const int *radii = gm_display_panel_get_corner_radii_array (panel);
-  GListModel *cutouts;
-
-  g_string_append_printf (svg,
-    "    <svg width=\"%d\" height=\"%d\">\n"
-    "      <g transform=\"translate(%d,%d)\">\n"
-    "        <!-- The panel -->\n"
-    "        <path d=\"M0 %d"
-                    "  a %d %d 0 0 1 %d %d"
-                    "  h%d"
-                    "  a %d %d 0 0 1 %d %d"
-                    "  v%d"
-                    "  a %d %d 0 0 1 %d %d"
-                    "  h%d"
-                    "  a %d %d 0 0 1 %d %d"
-                    "  Z \""
-                    " stroke=\"black\" stroke-width=\"2\" fill=\"lightgrey\" />\n",
-                          xres + 2 * X_OFF, yres + 2 * Y_OFF,
-                          X_OFF, Y_OFF,
-                          radii[0],
-                          radii[0], radii[0], radii[0], -radii[0],
-                          xres - radii[0] - radii[1],
-                          radii[1], radii[1], radii[1], radii[1],
-                          yres - radii[1] - radii[2],
-                          radii[2], radii[2], -radii[2], radii[2],
-                          -xres + radii[2] + radii[3],
-                          radii[3], radii[3], -radii[3], -radii[3]);
-
-  cutouts = gm_display_panel_get_cutouts (panel);
-  for (int i = 0; i < g_list_model_get_n_items (cutouts); i++) {
-    g_autoptr (GmCutout) cutout = g_list_model_get_item (cutouts, i);
-    if (cutout) {
-      const GmRect *bounds = gm_cutout_get_bounds (cutout);
-      const char *name = gm_cutout_get_name (cutout) ?: "";
-      const char *cutout_path = gm_cutout_get_path (cutout);
-
-      if (cutout_path == NULL) {
-        g_warning ("Failed to get cutout path for '%s' - skipping", name);
-        continue;
-      }
-
-      g_string_append_printf (svg,
-    "        <!-- cutout %s -->\n"
-    "        <path d=\"%s\" stroke=\"black\" stroke-width=\"2\" fill=\"none\" />\n",
-                              name,
-                              cutout_path);
-      g_string_append_printf (svg,
-    "        <!-- bbox of cutout %s -->\n"
-    "        <rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\""
-                        " fill=\"red\" fill-opacity=\"0.1\" />\n",
-                              name,
-                              bounds->x, bounds->y, bounds->width, bounds->height);
-      }
-  }
-
-  g_string_append_printf (svg,
-     "      </g>\n"
-     "    </svg>\n");
-
-  return g_string_free (svg, FALSE);
-}
-
-
 static char *
 build_html (GmDisplayPanel *panel)
 {
   GString *html = g_string_new ("");
   g_autofree char *svg = NULL;
 
-  svg = build_svg (panel);
+  svg = panel_svg_build (panel);
   g_string_append_printf (html,
     "<!DOCTYPE html>\n"
     "<html>\n"
@@ -114,13 +45,38 @@ build_html (GmDisplayPanel *panel)
 }
 
 
+static GBytes *
+build_raster (GmDisplayPanel *panel, gboolean png, GError **err)
+{
+  g_autoptr (PanelRaster) raster = NULL;
+
+  raster = panel_raster_render (panel, err);
+  if (raster == NULL)
+    return NULL;
+
+#ifdef GM_HAVE_ZLIB
+  if (png)
+    return panel_raster_to_png (raster, err);
+#else
+  if (png) {
+    g_set_error_literal (err, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED, "Built without PNG support");
+    return NULL;
+  }
+#endif
+
+  return panel_raster_to_pgm (raster);
+}
+
+
 int main (int argc, char **argv)
 {
   g_autoptr (GOptionContext) opt_context = NULL;
   gboolean version = FALSE;
   gboolean svg = FALSE;
+  gboolean pgm = FALSE;
+  gboolean png = FALSE;
   const char *output_file = NULL;
-  g_autofree char *content = NULL;
+  g_autoptr (GBytes) content = NULL;
   g_autoptr (GError) err = NULL;
   g_autoptr (GmDeviceInfo) info = NULL;
   g_auto (GStrv) compatibles = NULL;
@@ -134,6 +90,10 @@ int main (int argc, char **argv)
      "The output file name", NULL},
     {"svg", 's', 0, G_OPTION_ARG_NONE, &svg,
      "Output svg instead of html", NULL},
+    {"pgm", 0, 0, G_OPTION_ARG_NONE, &pgm,
+     "Output a PGM image instead of html", NULL},
+    {"png", 0, 0, G_OPTION_ARG_NONE, &png,
+     "Output a PNG image instead of html", NULL},
     {"version", 0, 0, G_OPTION_ARG_NONE, &version,
      "Show version information", NULL},
     { NULL, 0, 0, G_OPTION_ARG_NONE, NULL, NULL, NULL }
@@ -167,26 +127,33 @@ int main (int argc, char **argv)
     return EXIT_FAILURE;
   }
 
-  if (svg)
-    content = build_svg (panel);
-  else
-    content = build_html (panel);
+  if (pgm || png) {
+    content = build_raster (panel, png, &err);
+    if (content == NULL) {
+      g_critical ("Failed to render panel: %s", err->message);
+      return EXIT_FAILURE;
+    }
+  } else {
+    char *str = svg ? panel_svg_build (panel) : build_html (panel);
+
+    content = g_bytes_new_take (str, strlen (str));
+  }
 
   if (output_file) {
     g_autoptr (GFile) dest = g_file_new_for_path (output_file);
 
     if (!g_file_replace_contents (dest,
-                                  content,
-                                  strlen (content),
+                                  g_bytes_get_data (content, NULL),
+                                  g_bytes_get_size (content),
                                   NULL, FALSE,
                                   G_FILE_CREATE_REPLACE_DESTINATION,
                                   NULL, NULL,
                                   &err)) {
-      g_critical ("Failed to write html: %s", err->message);
+      g_critical ("Failed to write output: %s", err->message);
       return EXIT_FAILURE;
     }
   } else {
-    g_printf ("%s", content);
+    fwrite (g_bytes_get_data (content, NULL), 1, g_bytes_get_size (content), stdout);
   }
 
   return EXIT_SUCCESS;
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3-or-later
+ */
+
+/*
+ * Load all display panels of the device database in parallel and
+ * write a single HTML report with their previews. Meant to validate
+ * panel data quickly.
+ */
+
+#define GMOBILE_USE_UNSTABLE_API
+#include "gmobile.h"
+
+#include "panel-svg.h"
+
+#include <gio/gio.h>
+#include <glib/gprintf.h>
+
+#define GM_DISPLAY_PANEL_RESOURCE_PREFIX "/mobi/phosh/gmobile/devices/display-panels/"
+
+typedef struct {
+  const char *device;
+  char       *name;
+  char       *svg;
+  char       *error;
+  gint64      elapsed_us;
+} RenderJob;
+
+
+static void
+print_version (void)
+{
+  g_printf ("gm-display-panel-render-all %s\n", GM_VERSION);
+  exit (0);
+}
+
+
+static void
+render_job_clear (RenderJob *job)
+{
+  g_clear_pointer (&job->name, g_free);
+  g_clear_pointer (&job->svg, g_free);
+  g_clear_pointer (&job->error, g_free);
+}
+
+
+static void
+render_panel (gpointer data, gpointer user_data)
+{
+  RenderJob *job = data;
+  g_autoptr (GmDisplayPanel) panel = NULL;
+  g_autofree char *resource = NULL;
+  g_autoptr (GError) err = NULL;
+  gint64 start = g_get_monotonic_time ();
+
+  resource = g_strconcat (GM_DISPLAY_PANEL_RESOURCE_PREFIX, job->device, ".json", NULL);
+  panel = gm_display_panel_new_from_resource (resource, &err);
+  if (panel) {
+    job->name = g_strdup (gm_display_panel_get_name (panel));
+    job->svg = panel_svg_build (panel);
+  } else {
+    job->error = g_strdup (err->message);
+  }
+
+  job->elapsed_us = g_get_monotonic_time () - start;
+}
+
+
+static char *
+build_report (RenderJob *jobs, guint n_jobs)
+{
+  GString *html = g_string_new ("");
+
+  g_string_append (html,
+    "<!DOCTYPE html>\n"
+    "<html>\n"
+    "  <head>\n"
+    "    <title>gmobile display panels</title>\n"
+    "    <meta http-equiv=\"Content-Type\" content=\"text/html; charset=utf-8\" />\n"
+    "  </head>\n"
+    "  <body>\n");
+
+  for (guint i = 0; i < n_jobs; i++) {
+    g_autofree char *device = g_markup_escape_text (jobs[i].device, -1);
+
+    if (jobs[i].error) {
+      g_autofree char *error = g_markup_escape_text (jobs[i].error, -1);
+
+      g_string_append_printf (html,
+        "    <h2 id=\"%s\">%s</h2>\n"
+        "    <p style=\"color: red\">%s</p>\n",
+                              device, device, error);
+    } else {
+      g_autofree char *name = g_markup_escape_text (jobs[i].name ?: "", -1);
+
+      g_string_append_printf (html,
+        "    <h2 id=\"%s\">%s: %s</h2>\n"
+        "%s",
+                              device, device, name, jobs[i].svg);
+    }
+  }
+
+  g_string_append (html,
+    "  </body>\n"
+    "</html>\n");
+
+  return g_string_free (html, FALSE);
+}
+
+
+int main (int argc, char **argv)
+{
+  g_autoptr (GOptionContext) opt_context = NULL;
+  g_autoptr (GError) err = NULL;
+  g_autofree RenderJob *jobs = NULL;
+  g_autofree char *content = NULL;
+  g_auto (GStrv) devices = NULL;
+  gboolean version = FALSE;
+  const char *output_file = NULL;
+  int n_threads = 0;
+  GThreadPool *pool;
+  guint n_jobs, n_failed = 0;
+  gint64 start, total_us;
+
+  const GOptionEntry options [] = {
+    {"output", 'o', 0, G_OPTION_ARG_STRING, &output_file,
+     "The output file name", NULL},
+    {"jobs", 'j', 0, G_OPTION_ARG_INT, &n_threads,
+     "The number of threads (default: number of processors)", NULL},
+    {"version", 0, 0, G_OPTION_ARG_NONE, &version,
+     "Show version information", NULL},
+    { NULL, 0, 0, G_OPTION_ARG_NONE, NULL, NULL, NULL }
+  };
+
+  opt_context = g_option_context_new ("- render all panel previews");
+  g_option_context_add_main_entries (opt_context, options, NULL);
+  if (!g_option_context_parse (opt_context, &argc, &argv, &err)) {
+    g_warning ("%s", err->message);
+    g_clear_error (&err);
+    return EXIT_FAILURE;
+  }
+
+  if (version)
+    print_version ();
+
+  if (n_threads <= 0)
+    n_threads = g_get_num_processors ();
+
+  start = g_get_monotonic_time ();
+
+  devices = gm_list_devices ();
+  n_jobs = g_strv_length (devices);
+  jobs = g_new0 (RenderJob, n_jobs);
+
+  pool = g_thread_pool_new (render_panel, NULL, n_threads, TRUE, &err);
+  if (pool == NULL) {
+    g_critical ("Failed to create thread pool: %s", err->message);
+    return EXIT_FAILURE;
+  }
+
+  for (guint i = 0; i < n_jobs; i++) {
+    jobs[i].device = devices[i];
+    if (!g_thread_pool_push (pool, &jobs[i], &err)) {
+      g_critical ("Failed to queue %s: %s", devices[i], err->message);
+      return EXIT_FAILURE;
+    }
+  }
+  /* Wait for all jobs to finish */
+  g_thread_pool_free (pool, FALSE, TRUE);
+
+  total_us = g_get_monotonic_time () - start;
+
+  for (guint i = 0; i < n_jobs; i++) {
+    g_printerr ("%-32s %8.3f ms%s%s\n", jobs[i].device, jobs[i].elapsed_us / 1000.0,
+                jobs[i].error ? "  FAILED: " : "", jobs[i].error ?: "");
+    if (jobs[i].error)
+      n_failed++;
+  }
+  g_printerr ("%u panels, %u failed, %d threads, %.3f ms total\n",
+              n_jobs, n_failed, n_threads, total_us / 1000.0);
+
+  content = build_report (jobs, n_jobs);
+  for (guint i = 0; i < n_jobs; i++)
+    render_job_clear (&jobs[i]);
+
+  if (output_file) {
+    g_autoptr (GFile) dest = g_file_new_for_path (output_file);
+
+    if (!g_file_replace_contents (dest,
+                                  content,
+                                  strlen (content),
+                                  NULL, FALSE,
+                                  G_FILE_CREATE_REPLACE_DESTINATION,
+                                  NULL, NULL,
+                                  &err)) {
+      g_critical ("Failed to write html: %s", err->message);
+      return EXIT_FAILURE;
+    }
+  } else {
+    g_printf ("%s", content);
+  }
+
+  return n_failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
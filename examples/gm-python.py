@@ -16,3 +16,9 @@ height = panel.get_height()
 radii = panel.get_corner_radii()
 
 print(f"{dt}: {width}x{height}, corner radii: {radii}")
+
+# Fetch the geometry of all known devices in a single call
+geometries = Gm.DeviceInfo.lookup_panel_geometries(Gm.list_devices()).unpack()
+for dt, (name, x_res, y_res, width, height, radii, cutouts) in sorted(geometries.items()):
+    print(f"{dt}: {name}, {x_res}x{y_res}px, {width}x{height}mm, "
+          f"corner radii: {list(radii)}, {len(cutouts)} cutouts")
@@ -0,0 +1,625 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3-or-later
+ */
+
+/*
+ * A minimal software rasterizer for display panels. It doesn't do any
+ * anti aliasing: a pixel is set when its center is inside the shape so
+ * the output is suitable for pixel exact comparisons.
+ */
+
+#include "panel-raster.h"
+
+#include <math.h>
+#include <string.h>
+
+#ifdef GM_HAVE_ZLIB
+# include <zlib.h>
+#endif
+
+/* Number of line segments used for a bezier curve */
+#define BEZIER_SEGMENTS 32
+/* Maximum angle covered by a single line segment of an arc */
+#define ARC_STEP (G_PI / 64.0)
+/* Vertices are snapped to this grid so that tiny differences in
+ * floating point math don't change the output */
+#define SNAP 1024.0
+
+typedef struct {
+  double x0, y0;
+  double x1, y1;
+} Edge;
+
+typedef struct {
+  double x;
+  int    dir;
+} Crossing;
+
+typedef struct {
+  GArray *edges;
+  /* The current point */
+  double  x, y;
+  /* Start of the current sub path */
+  double  sx, sy;
+} Flattener;
+
+
+static inline double
+snap (double v)
+{
+  return round (v * SNAP) / SNAP;
+}
+
+
+static void
+line_to (Flattener *f, double x, double y)
+{
+  Edge edge = { snap (f->x), snap (f->y), snap (x), snap (y) };
+
+  /* Horizontal edges never cross a scan line */
+  if (edge.y0 != edge.y1)
+    g_array_append_val (f->edges, edge);
+
+  f->x = x;
+  f->y = y;
+}
+
+
+static void
+close_subpath (Flattener *f)
+{
+  line_to (f, f->sx, f->sy);
+}
+
+
+static void
+quad_to (Flattener *f, double cx, double cy, double x, double y)
+{
+  double x0 = f->x, y0 = f->y;
+
+  for (int i = 1; i < BEZIER_SEGMENTS; i++) {
+    double t = (double) i / BEZIER_SEGMENTS;
+    double mt = 1.0 - t;
+
+    line_to (f,
+             mt * mt * x0 + 2 * mt * t * cx + t * t * x,
+             mt * mt * y0 + 2 * mt * t * cy + t * t * y);
+  }
+  line_to (f, x, y);
+}
+
+
+static void
+cubic_to (Flattener *f, double cx1, double cy1, double cx2, double cy2, double x, double y)
+{
+  double x0 = f->x, y0 = f->y;
+
+  for (int i = 1; i < BEZIER_SEGMENTS; i++) {
+    double t = (double) i / BEZIER_SEGMENTS;
+    double mt = 1.0 - t;
+
+    line_to (f,
+             mt * mt * mt * x0 + 3 * mt * mt * t * cx1 + 3 * mt * t * t * cx2 + t * t * t * x,
+             mt * mt * mt * y0 + 3 * mt * mt * t * cy1 + 3 * mt * t * t * cy2 + t * t * t * y);
+  }
+  line_to (f, x, y);
+}
+
+
+/* See https://www.w3.org/TR/SVG11/implnote.html#ArcConversionEndpointToCenter */
+static void
+arc_to (Flattener *f,
+        double     rx,
+        double     ry,
+        double     xrot,
+        gboolean   large_arc,
+        gboolean   sweep,
+        double     x,
+        double     y)
+{
+  double x1 = f->x, y1 = f->y;
+  double phi, cos_phi, sin_phi, x1p, y1p, lambda, num, den, coef;
+  double cxp, cyp, cx, cy, ux, uy, vx, vy, theta1, dtheta;
+  int n;
+
+  if (x1 == x && y1 == y)
+    return;
+
+  rx = fabs (rx);
+  ry = fabs (ry);
+  if (rx == 0.0 || ry == 0.0) {
+    line_to (f, x, y);
+    return;
+  }
+
+  phi = xrot * G_PI / 180.0;
+  cos_phi = cos (phi);
+  sin_phi = sin (phi);
+  x1p = cos_phi * (x1 - x) / 2 + sin_phi * (y1 - y) / 2;
+  y1p = -sin_phi * (x1 - x) / 2 + cos_phi * (y1 - y) / 2;
+
+  /* Scale up radii that are too small to reach the end point */
+  lambda = (x1p * x1p) / (rx * rx) + (y1p * y1p) / (ry * ry);
+  if (lambda > 1.0) {
+    rx *= sqrt (lambda);
+    ry *= sqrt (lambda);
+  }
+
+  num = rx * rx * ry * ry - rx * rx * y1p * y1p - ry * ry * x1p * x1p;
+  den = rx * rx * y1p * y1p + ry * ry * x1p * x1p;
+  coef = num > 0.0 ? sqrt (num / den) : 0.0;
+  if (large_arc == sweep)
+    coef = -coef;
+
+  cxp = coef * rx * y1p / ry;
+  cyp = -coef * ry * x1p / rx;
+  cx = cos_phi * cxp - sin_phi * cyp + (x1 + x) / 2;
+  cy = sin_phi * cxp + cos_phi * cyp + (y1 + y) / 2;
+
+  ux = (x1p - cxp) / rx;
+  uy = (y1p - cyp) / ry;
+  vx = (-x1p - cxp) / rx;
+  vy = (-y1p - cyp) / ry;
+  theta1 = atan2 (uy, ux);
+  dtheta = atan2 (ux * vy - uy * vx, ux * vx + uy * vy);
+  if (!sweep && dtheta > 0)
+    dtheta -= 2 * G_PI;
+  else if (sweep && dtheta < 0)
+    dtheta += 2 * G_PI;
+
+  n = MAX (1, (int) ceil (fabs (dtheta) / ARC_STEP));
+  for (int i = 1; i < n; i++) {
+    double t = theta1 + dtheta * i / n;
+
+    line_to (f,
+             cx + rx * cos_phi * cos (t) - ry * sin_phi * sin (t),
+             cy + rx * sin_phi * cos (t) + ry * cos_phi * sin (t));
+  }
+  line_to (f, x, y);
+}
+
+
+static void
+skip_separators (const char **p)
+{
+  while (**p == ',' || g_ascii_isspace (**p))
+    (*p)++;
+}
+
+
+static gboolean
+is_number_start (const char *p)
+{
+  skip_separators (&p);
+  return g_ascii_isdigit (*p) || *p == '-' || *p == '+' || *p == '.';
+}
+
+
+static gboolean
+read_numbers (const char **p, double *vals, guint n_vals, GError **err)
+{
+  for (guint i = 0; i < n_vals; i++) {
+    char *end;
+
+    skip_separators (p);
+    if (!is_number_start (*p)) {
+      g_set_error (err, GM_ERROR, GM_ERROR_PARSING_FAILED, "Expected number at '%.16s'", *p);
+      return FALSE;
+    }
+
+    vals[i] = g_ascii_strtod (*p, &end);
+    if (end == *p || !isfinite (vals[i])) {
+      g_set_error (err, GM_ERROR, GM_ERROR_PARSING_FAILED, "'%.16s' is not a number", *p);
+      return FALSE;
+    }
+    *p = end;
+  }
+
+  return TRUE;
+}
+
+
+static gboolean
+flatten_path (Flattener *f, const char *path, GError **err)
+{
+  const char *p = path;
+  char cmd = '\0';
+
+  while (TRUE) {
+    double v[7];
+    double dx, dy;
+    gboolean rel;
+
+    skip_separators (&p);
+    if (*p == '\0')
+      break;
+
+    if (g_ascii_isalpha (*p)) {
+      cmd = *p++;
+    } else if (cmd == '\0' || cmd == 'Z' || cmd == 'z') {
+      g_set_error (err, GM_ERROR, GM_ERROR_PARSING_FAILED, "Expected command at '%.16s'", p);
+      return FALSE;
+    } else if (cmd == 'M') {
+      /* Coordinates following a move are implicit line commands */
+      cmd = 'L';
+    } else if (cmd == 'm') {
+      cmd = 'l';
+    }
+
+    rel = g_ascii_islower (cmd);
+    dx = rel ? f->x : 0.0;
+    dy = rel ? f->y : 0.0;
+
+    switch (g_ascii_toupper (cmd)) {
+    case 'M': /* x,y */
+      if (!read_numbers (&p, v, 2, err))
+        return FALSE;
+      close_subpath (f);
+      f->x = f->sx = dx + v[0];
+      f->y = f->sy = dy + v[1];
+      break;
+    case 'L': /* x,y */
+      if (!read_numbers (&p, v, 2, err))
+        return FALSE;
+      line_to (f, dx + v[0], dy + v[1]);
+      break;
+    case 'H': /* x */
+      if (!read_numbers (&p, v, 1, err))
+        return FALSE;
+      line_to (f, dx + v[0], f->y);
+      break;
+    case 'V': /* y */
+      if (!read_numbers (&p, v, 1, err))
+        return FALSE;
+      line_to (f, f->x, dy + v[0]);
+      break;
+    case 'Q': /* cx,cy x,y */
+      if (!read_numbers (&p, v, 4, err))
+        return FALSE;
+      quad_to (f, dx + v[0], dy + v[1], dx + v[2], dy + v[3]);
+      break;
+    case 'C': /* cx1,cy1 cx2,cy2 x,y */
+      if (!read_numbers (&p, v, 6, err))
+        return FALSE;
+      cubic_to (f, dx + v[0], dy + v[1], dx + v[2], dy + v[3], dx + v[4], dy + v[5]);
+      break;
+    case 'A': /* rx ry x-axis-rotation large-arc-flag sweep-flag x y */
+      if (!read_numbers (&p, v, 7, err))
+        return FALSE;
+      arc_to (f, v[0], v[1], v[2], v[3] != 0.0, v[4] != 0.0, dx + v[5], dy + v[6]);
+      break;
+    case 'Z':
+      close_subpath (f);
+      f->x = f->sx;
+      f->y = f->sy;
+      break;
+    default:
+      g_set_error (err, GM_ERROR, GM_ERROR_PARSING_FAILED, "Unknown command '%c'", cmd);
+      return FALSE;
+    }
+  }
+
+  /* Filling implicitly closes open sub paths */
+  close_subpath (f);
+
+  return TRUE;
+}
+
+
+static void
+fill_span (PanelRaster *raster, int y, double x0, double x1, guint8 value)
+{
+  int start, end;
+
+  /* Pixels whose center is in [x0, x1) */
+  x0 = CLAMP (x0, 0.0, raster->width);
+  x1 = CLAMP (x1, 0.0, raster->width);
+  start = (int) ceil (x0 - 0.5);
+  end = (int) ceil (x1 - 0.5);
+
+  if (start < end)
+    memset (raster->pixels + (gsize) y * raster->width + start, value, end - start);
+}
+
+
+static int
+compare_crossings (gconstpointer a, gconstpointer b)
+{
+  const Crossing *ca = a;
+  const Crossing *cb = b;
+
+  if (ca->x < cb->x)
+    return -1;
+  if (ca->x > cb->x)
+    return 1;
+
+  return ca->dir - cb->dir;
+}
+
+/**
+ * panel_raster_new:
+ * @width: The width in pixels
+ * @height: The height in pixels
+ *
+ * Creates a new raster with all pixels set to `PANEL_RASTER_OUTSIDE`.
+ *
+ * Returns: The new raster
+ */
+PanelRaster *
+panel_raster_new (int width, int height)
+{
+  PanelRaster *raster;
+
+  g_return_val_if_fail (width > 0 && height > 0, NULL);
+
+  raster = g_new0 (PanelRaster, 1);
+  raster->width = width;
+  raster->height = height;
+  raster->pixels = g_malloc ((gsize) width * height);
+  memset (raster->pixels, PANEL_RASTER_OUTSIDE, (gsize) width * height);
+
+  return raster;
+}
+
+
+void
+panel_raster_free (PanelRaster *raster)
+{
+  g_free (raster->pixels);
+  g_free (raster);
+}
+
+
+static double
+corner_inset (int radius, double dist)
+{
+  double dy;
+
+  if (radius <= 0 || dist >= radius)
+    return 0.0;
+
+  dy = radius - dist;
+  return radius - sqrt ((double) radius * radius - dy * dy);
+}
+
+/**
+ * panel_raster_fill_rounded_rect:
+ * @raster: The raster
+ * @radii: The corner radii: top-left, top-right, bottom-right, bottom-left
+ * @value: The pixel value to fill with
+ *
+ * Fills the whole raster with the given value, leaving out the rounded
+ * corners.
+ */
+void
+panel_raster_fill_rounded_rect (PanelRaster *raster, const int *radii, guint8 value)
+{
+  for (int y = 0; y < raster->height; y++) {
+    double cy = y + 0.5;
+    double left, right;
+
+    left = MAX (corner_inset (radii[0], cy), corner_inset (radii[3], raster->height - cy));
+    right = MAX (corner_inset (radii[1], cy), corner_inset (radii[2], raster->height - cy));
+    fill_span (raster, y, left, raster->width - right, value);
+  }
+}
+
+/**
+ * panel_raster_fill_path:
+ * @raster: The raster
+ * @path: An SVG path
+ * @value: The pixel value to fill with
+ * @err: Return location for an error
+ *
+ * Fills the given SVG path using the non zero winding rule. Curves
+ * are approximated by line segments.
+ *
+ * Returns: `TRUE` on success, `FALSE` if the path can't be parsed.
+ */
+gboolean
+panel_raster_fill_path (PanelRaster *raster, const char *path, guint8 value, GError **err)
+{
+  g_autoptr (GArray) edges = g_array_new (FALSE, FALSE, sizeof (Edge));
+  g_autoptr (GArray) crossings = g_array_new (FALSE, FALSE, sizeof (Crossing));
+  Flattener f = { .edges = edges };
+  double ymin = G_MAXDOUBLE, ymax = -G_MAXDOUBLE;
+  int row_start, row_end;
+
+  g_return_val_if_fail (path, FALSE);
+
+  if (!flatten_path (&f, path, err))
+    return FALSE;
+
+  for (guint i = 0; i < edges->len; i++) {
+    Edge *e = &g_array_index (edges, Edge, i);
+
+    ymin = MIN (ymin, MIN (e->y0, e->y1));
+    ymax = MAX (ymax, MAX (e->y0, e->y1));
+  }
+  if (edges->len == 0)
+    return TRUE;
+
+  ymin = CLAMP (ymin, 0.0, raster->height);
+  ymax = CLAMP (ymax, 0.0, raster->height);
+  row_start = (int) ceil (ymin - 0.5);
+  row_end = (int) ceil (ymax - 0.5);
+
+  for (int y = row_start; y < row_end; y++) {
+    double cy = y + 0.5;
+    int winding = 0;
+    double span_start = 0.0;
+
+    g_array_set_size (crossings, 0);
+    for (guint i = 0; i < edges->len; i++) {
+      Edge *e = &g_array_index (edges, Edge, i);
+      Crossing c;
+
+      /* Half open so that shared vertices are only counted once */
+      if (cy < MIN (e->y0, e->y1) || cy >= MAX (e->y0, e->y1))
+        continue;
+
+      c.x = e->x0 + (cy - e->y0) * (e->x1 - e->x0) / (e->y1 - e->y0);
+      c.dir = e->y1 > e->y0 ? 1 : -1;
+      g_array_append_val (crossings, c);
+    }
+    g_array_sort (crossings, compare_crossings);
+
+    for (guint i = 0; i < crossings->len; i++) {
+      Crossing *c = &g_array_index (crossings, Crossing, i);
+
+      if (winding == 0)
+        span_start = c->x;
+      winding += c->dir;
+      if (winding == 0)
+        fill_span (raster, y, span_start, c->x, value);
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * panel_raster_render:
+ * @panel: The display panel
+ * @err: Return location for an error
+ *
+ * Renders the panel's outline, corner radii and cutouts. Pixels outside
+ * of the panel are `PANEL_RASTER_OUTSIDE`, pixels of the panel
+ * `PANEL_RASTER_PANEL` and pixels covered by a cutout
+ * `PANEL_RASTER_CUTOUT`.
+ *
+ * Returns: The rendered panel or %NULL on error
+ */
+PanelRaster *
+panel_raster_render (GmDisplayPanel *panel, GError **err)
+{
+  g_autoptr (PanelRaster) raster = NULL;
+  int xres = gm_display_panel_get_x_res (panel);
+  int yres = gm_display_panel_get_y_res (panel);
+  GListModel *cutouts;
+
+  if (xres <= 0 || yres <= 0) {
+    g_set_error (err, GM_ERROR, GM_ERROR_PARSING_FAILED, "Invalid resolution %dx%d", xres, yres);
+    return NULL;
+  }
+
+  raster = panel_raster_new (xres, yres);
+  panel_raster_fill_rounded_rect (raster,
+                                  gm_display_panel_get_corner_radii_array (panel),
+                                  PANEL_RASTER_PANEL);
+
+  cutouts = gm_display_panel_get_cutouts (panel);
+  for (guint i = 0; i < g_list_model_get_n_items (cutouts); i++) {
+    g_autoptr (GmCutout) cutout = g_list_model_get_item (cutouts, i);
+    const char *path = gm_cutout_get_path (cutout);
+
+    if (path == NULL)
+      continue;
+
+    if (!panel_raster_fill_path (raster, path, PANEL_RASTER_CUTOUT, err)) {
+      g_prefix_error (err, "Cutout '%s': ", gm_cutout_get_name (cutout) ?: "");
+      return NULL;
+    }
+  }
+
+  return g_steal_pointer (&raster);
+}
+
+/**
+ * panel_raster_to_pgm:
+ * @raster: The raster
+ *
+ * Encodes the raster as binary Netpbm greymap.
+ *
+ * Returns: The image data
+ */
+GBytes *
+panel_raster_to_pgm (PanelRaster *raster)
+{
+  GByteArray *pgm = g_byte_array_new ();
+  g_autofree char *header = NULL;
+
+  header = g_strdup_printf ("P5\n%d %d\n255\n", raster->width, raster->height);
+  g_byte_array_append (pgm, (const guint8 *) header, strlen (header));
+  g_byte_array_append (pgm, raster->pixels, (gsize) raster->width * raster->height);
+
+  return g_byte_array_free_to_bytes (pgm);
+}
+
+#ifdef GM_HAVE_ZLIB
+
+static void
+append_be32 (GByteArray *array, guint32 val)
+{
+  guint8 buf[4] = { val >> 24, val >> 16, val >> 8, val };
+
+  g_byte_array_append (array, buf, sizeof (buf));
+}
+
+
+static void
+append_png_chunk (GByteArray *png, const char *type, const guint8 *data, gsize len)
+{
+  uLong crc;
+
+  append_be32 (png, len);
+  g_byte_array_append (png, (const guint8 *) type, 4);
+  g_byte_array_append (png, data, len);
+
+  crc = crc32 (0L, (const Bytef *) type, 4);
+  crc = crc32 (crc, data, len);
+  append_be32 (png, crc);
+}
+
+/**
+ * panel_raster_to_png:
+ * @raster: The raster
+ * @err: Return location for an error
+ *
+ * Encodes the raster as 8 bit greyscale PNG.
+ *
+ * Returns: The image data or %NULL on error
+ */
+GBytes *
+panel_raster_to_png (PanelRaster *raster, GError **err)
+{
+  static const guint8 signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+  g_autoptr (GByteArray) png = g_byte_array_new ();
+  g_autoptr (GByteArray) ihdr = g_byte_array_new ();
+  g_autofree guint8 *rows = NULL;
+  g_autofree guint8 *idat = NULL;
+  gsize stride = (gsize) raster->width + 1;
+  gsize rows_len = stride * raster->height;
+  /* bit depth, color type, compression, filter, interlace */
+  const guint8 format[] = { 8, 0, 0, 0, 0 };
+  uLongf idat_len;
+  int ret;
+
+  /* Each row is prefixed by its filter type, we don't filter */
+  rows = g_malloc0 (rows_len);
+  for (int y = 0; y < raster->height; y++)
+    memcpy (rows + y * stride + 1, raster->pixels + (gsize) y * raster->width, raster->width);
+
+  idat_len = compressBound (rows_len);
+  idat = g_malloc (idat_len);
+  ret = compress2 (idat, &idat_len, rows, rows_len, Z_BEST_COMPRESSION);
+  if (ret != Z_OK) {
+    g_set_error (err, G_IO_ERROR, G_IO_ERROR_FAILED, "Failed to compress image: %d", ret);
+    return NULL;
+  }
+
+  append_be32 (ihdr, raster->width);
+  append_be32 (ihdr, raster->height);
+  g_byte_array_append (ihdr, format, sizeof (format));
+
+  g_byte_array_append (png, signature, sizeof (signature));
+  append_png_chunk (png, "IHDR", ihdr->data, ihdr->len);
+  append_png_chunk (png, "IDAT", idat, idat_len);
+  append_png_chunk (png, "IEND", (const guint8 *) "", 0);
+
+  return g_byte_array_free_to_bytes (g_steal_pointer (&png));
+}
+
+#endif
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3-or-later
+ */
+
+#pragma once
+
+#define GMOBILE_USE_UNSTABLE_API
+#include "gmobile.h"
+
+G_BEGIN_DECLS
+
+/* Pixel values used when rendering a panel */
+#define PANEL_RASTER_OUTSIDE 0x00
+#define PANEL_RASTER_PANEL   0xd3
+#define PANEL_RASTER_CUTOUT  0x40
+
+typedef struct {
+  int     width;
+  int     height;
+  guint8 *pixels;
+} PanelRaster;
+
+PanelRaster *panel_raster_new               (int          width,
+                                             int          height);
+void         panel_raster_free              (PanelRaster *raster);
+void         panel_raster_fill_rounded_rect (PanelRaster *raster,
+                                             const int   *radii,
+                                             guint8       value);
+gboolean     panel_raster_fill_path         (PanelRaster *raster,
+                                             const char  *path,
+                                             guint8       value,
+                                             GError     **err);
+PanelRaster *panel_raster_render            (GmDisplayPanel *panel,
+                                             GError        **err);
+GBytes      *panel_raster_to_pgm            (PanelRaster *raster);
+#ifdef GM_HAVE_ZLIB
+GBytes      *panel_raster_to_png            (PanelRaster *raster,
+                                             GError     **err);
+#endif
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (PanelRaster, panel_raster_free)
+
+G_END_DECLS
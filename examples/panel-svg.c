@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2022 The Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3-or-later
+ *
+ * Author: Guido Günther <agx@sigxcpu.org>
+ */
+
+#include "panel-svg.h"
+
+#define X_OFF 5
+#define Y_OFF 5
+
+/**
+ * panel_svg_build:
+ * @panel: The display panel
+ *
+ * Builds an SVG showing the panel's outline, corner radii and cutouts.
+ *
+ * Returns: The SVG
+ */
+char *
+panel_svg_build (GmDisplayPanel *panel)
+{
+  GString *svg = g_string_new ("");
+  int xres = gm_display_panel_get_x_res (panel);
+  int yres = gm_display_panel_get_y_res (panel);
+  const int *radii = gm_display_panel_get_corner_radii_array (panel);
+  GListModel *cutouts;
+
+  g_string_append_printf (svg,
+    "    <svg width=\"%d\" height=\"%d\">\n"
+    "      <g transform=\"translate(%d,%d)\">\n"
+    "        <!-- The panel -->\n"
+    "        <path d=\"M0 %d"
+                    "  a %d %d 0 0 1 %d %d"
+                    "  h%d"
+                    "  a %d %d 0 0 1 %d %d"
+                    "  v%d"
+                    "  a %d %d 0 0 1 %d %d"
+                    "  h%d"
+                    "  a %d %d 0 0 1 %d %d"
+                    "  Z \""
+                    " stroke=\"black\" stroke-width=\"2\" fill=\"lightgrey\" />\n",
+                          xres + 2 * X_OFF, yres + 2 * Y_OFF,
+                          X_OFF, Y_OFF,
+                          radii[0],
+                          radii[0], radii[0], radii[0], -radii[0],
+                          xres - radii[0] - radii[1],
+                          radii[1], radii[1], radii[1], radii[1],
+                          yres - radii[1] - radii[2],
+                          radii[2], radii[2], -radii[2], radii[2],
+                          -xres + radii[2] + radii[3],
+                          radii[3], radii[3], -radii[3], -radii[3]);
+
+  cutouts = gm_display_panel_get_cutouts (panel);
+  for (int i = 0; i < g_list_model_get_n_items (cutouts); i++) {
+    g_autoptr (GmCutout) cutout = g_list_model_get_item (cutouts, i);
+    if (cutout) {
+      const GmRect *bounds = gm_cutout_get_bounds (cutout);
+      const char *name = gm_cutout_get_name (cutout) ?: "";
+      const char *cutout_path = gm_cutout_get_path (cutout);
+
+      if (cutout_path == NULL) {
+        g_warning ("Failed to get cutout path for '%s' - skipping", name);
+        continue;
+      }
+
+      g_string_append_printf (svg,
+    "        <!-- cutout %s -->\n"
+    "        <path d=\"%s\" stroke=\"black\" stroke-width=\"2\" fill=\"none\" />\n",
+                              name,
+                              cutout_path);
+      g_string_append_printf (svg,
+    "        <!-- bbox of cutout %s -->\n"
+    "        <rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\""
+                        " fill=\"red\" fill-opacity=\"0.1\" />\n",
+                              name,
+                              bounds->x, bounds->y, bounds->width, bounds->height);
+      }
+  }
+
+  g_string_append_printf (svg,
+     "      </g>\n"
+     "    </svg>\n");
+
+  return g_string_free (svg, FALSE);
+}
@@ -0,0 +1,16 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3-or-later
+ */
+
+#pragma once
+
+#define GMOBILE_USE_UNSTABLE_API
+#include "gmobile.h"
+
+G_BEGIN_DECLS
+
+char *panel_svg_build (GmDisplayPanel *panel);
+
+G_END_DECLS
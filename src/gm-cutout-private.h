@@ -0,0 +1,16 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#include "gm-cutout.h"
+#include "gm-display-panel-data-private.h"
+
+G_BEGIN_DECLS
+
+GmCutout      *gm_cutout_new_from_data (GmDisplayPanelCutoutData *data);
+
+G_END_DECLS
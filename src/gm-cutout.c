@@ -6,11 +6,14 @@
  * Author: Guido Günther <agx@sigxcpu.org>
  */
 
-#include "gm-cutout.h"
+#include "gm-cutout-private.h"
 #include "gm-rect.h"
+#include "gm-stats-private.h"
 #include "gm-svg-path.h"
 
-#include <json-glib/json-glib.h>
+#ifdef GM_HAVE_JSON_GLIB
+# include <json-glib/json-glib.h>
+#endif
 
 #include <gio/gio.h>
 
@@ -48,13 +51,18 @@ struct _GmCutout {
   GmRect    bounds;
 };
 
+#ifdef GM_HAVE_JSON_GLIB
 static void gm_cutout_json_serializable_iface_init (JsonSerializableIface *iface);
 
 G_DEFINE_TYPE_WITH_CODE (GmCutout, gm_cutout, G_TYPE_OBJECT,
                          G_IMPLEMENT_INTERFACE (JSON_TYPE_SERIALIZABLE,
                                                 gm_cutout_json_serializable_iface_init));
+#else
+G_DEFINE_TYPE (GmCutout, gm_cutout, G_TYPE_OBJECT)
+#endif
 
 
+#ifdef GM_HAVE_JSON_GLIB
 static JsonNode *
 gm_cutout_serializable_serialize_property (JsonSerializable *serializable,
                                            const gchar      *property_name,
@@ -80,6 +88,7 @@ gm_cutout_json_serializable_iface_init (JsonSerializableIface *iface)
 {
   iface->serialize_property = gm_cutout_serializable_serialize_property;
 }
+#endif
 
 
 static gboolean
@@ -168,6 +177,8 @@ gm_cutout_finalize (GObject *object)
   g_clear_pointer (&self->name, g_free);
   g_clear_pointer (&self->path, g_free);
 
+  gm_stats_object_removed (GM_STATS_OBJECT_CUTOUT, sizeof (GmCutout));
+
   G_OBJECT_CLASS (gm_cutout_parent_class)->finalize (object);
 }
 
@@ -222,6 +233,7 @@ gm_cutout_class_init (GmCutoutClass *klass)
 static void
 gm_cutout_init (GmCutout *self)
 {
+  gm_stats_object_added (GM_STATS_OBJECT_CUTOUT, sizeof (GmCutout));
 }
 
 /**
@@ -240,6 +252,27 @@ gm_cutout_new (const char *path)
   return GM_CUTOUT (g_object_new (GM_TYPE_CUTOUT, "path", path, NULL));
 }
 
+/**
+ * gm_cutout_new_from_data:
+ * @data: Parsed cutout data
+ *
+ * Create a new cutout from already parsed and validated data. The
+ * name and path are moved over from `data`.
+ *
+ * Returns: The cutout.
+ */
+GmCutout *
+gm_cutout_new_from_data (GmDisplayPanelCutoutData *data)
+{
+  GmCutout *self = GM_CUTOUT (g_object_new (GM_TYPE_CUTOUT, NULL));
+
+  self->name = g_steal_pointer (&data->name);
+  self->path = g_steal_pointer (&data->path);
+  self->bounds = data->bounds;
+
+  return self;
+}
+
 /**
  * gm_cutout_get_name:
  * @self: A cutout
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "gm-device-db-private.h"
+#include "gm-trace-private.h"
+
+#ifdef GM_HAVE_DEVICE_DB
+# include "gm-device-db-resources.h"
+#endif
+
+/*
+ * The device database is the bundled device data (currently the display
+ * panel descriptions). It's a separate resource that is only
+ * registered when it's needed so processes that never look up devices
+ * don't pay for it. It can be left out at build time via the
+ * `device_db` option.
+ */
+
+/**
+ * gm_device_db_get_resource:
+ *
+ * Gets the device database, registering it on first use. This is
+ * thread safe.
+ *
+ * Returns:(nullable)(transfer none): The device database or %NULL if
+ *   gmobile was built without it
+ */
+GResource *
+gm_device_db_get_resource (void)
+{
+#ifdef GM_HAVE_DEVICE_DB
+  static GResource *resource;
+
+  if (g_once_init_enter (&resource)) {
+    gint64 begin = GM_TRACE_CURRENT_TIME;
+
+    /*
+     * gmobile is currently meant as static library so register
+     * resources explicitly.  otherwise they get dropped during static
+     * linking
+     */
+    gm_device_db_data_register_resource ();
+    GM_TRACE_MARK (begin, "register-device-db", "Registered device database");
+    g_once_init_leave (&resource, gm_device_db_data_get_resource ());
+  }
+
+  return resource;
+#else
+  return NULL;
+#endif
+}
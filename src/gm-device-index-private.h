@@ -0,0 +1,19 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+const char * const *gm_device_index_get_names   (guint      *n_names);
+void                gm_device_index_find_prefix (const char *prefix,
+                                                 guint      *begin,
+                                                 guint      *end);
+gboolean            gm_device_index_contains    (const char *name);
+
+G_END_DECLS
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "gm-device-index-private.h"
+#include "gm-device-db-private.h"
+#include "gm-trace-private.h"
+
+#include <gio/gio.h>
+
+#include <string.h>
+
+#define GM_DISPLAY_PANEL_RESOURCE_PREFIX "/mobi/phosh/gmobile/devices/display-panels/"
+#define JSON_SUFFIX ".json"
+
+/*
+ * The index of known devices: the sorted names of all bundled display
+ * panel descriptions. It's built once on first use and lives as long
+ * as the process. The pointer array and the strings share a single
+ * allocation.
+ */
+typedef struct {
+  guint  n_names;
+  char  *names[];
+} GmDeviceIndex;
+
+
+static int
+compare_names (gconstpointer a, gconstpointer b)
+{
+  return strcmp (*(const char * const *)a, *(const char * const *)b);
+}
+
+
+static GmDeviceIndex *
+build_index (void)
+{
+  g_autoptr (GError) err = NULL;
+  g_auto (GStrv) children = NULL;
+  gint64 begin = GM_TRACE_CURRENT_TIME;
+  GResource *resource;
+  GmDeviceIndex *index;
+  gsize size = 0;
+  guint n = 0;
+  char *p;
+
+  /* Built without device database */
+  resource = gm_device_db_get_resource ();
+  if (resource) {
+    children = g_resource_enumerate_children (resource,
+                                              GM_DISPLAY_PANEL_RESOURCE_PREFIX,
+                                              G_RESOURCE_LOOKUP_FLAGS_NONE,
+                                              &err);
+    if (!children)
+      g_critical ("Failed to enumerate known devices: %s", err->message);
+  }
+
+  for (int i = 0; children && children[i]; i++) {
+    if (!g_str_has_suffix (children[i], JSON_SUFFIX))
+      continue;
+
+    size += strlen (children[i]) - strlen (JSON_SUFFIX) + 1;
+    n++;
+  }
+
+  index = g_malloc (sizeof (GmDeviceIndex) + (n + 1) * sizeof (char *) + size);
+  p = (char *)&index->names[n + 1];
+
+  index->n_names = 0;
+  for (int i = 0; children && children[i]; i++) {
+    gsize len;
+
+    if (!g_str_has_suffix (children[i], JSON_SUFFIX))
+      continue;
+
+    len = strlen (children[i]) - strlen (JSON_SUFFIX);
+    memcpy (p, children[i], len);
+    p[len] = '\0';
+    index->names[index->n_names++] = p;
+    p += len + 1;
+  }
+  index->names[index->n_names] = NULL;
+
+  qsort (index->names, index->n_names, sizeof (char *), compare_names);
+
+  GM_TRACE_MARK (begin, "build-device-index", "%u devices", index->n_names);
+
+  return index;
+}
+
+
+static const GmDeviceIndex *
+get_index (void)
+{
+  static GmDeviceIndex *index;
+
+  if (g_once_init_enter (&index))
+    g_once_init_leave (&index, build_index ());
+
+  return index;
+}
+
+/*
+ * Returns the first position in the index where comparing the first
+ * `len` bytes of the name against `key` isn't smaller (or isn't smaller
+ * or equal if `upper` is set) than 0.
+ */
+static guint
+bisect (const GmDeviceIndex *index, const char *key, gsize len, gboolean upper)
+{
+  guint lo = 0, hi = index->n_names;
+
+  while (lo < hi) {
+    guint mid = lo + (hi - lo) / 2;
+    int cmp = strncmp (index->names[mid], key, len);
+
+    if (cmp < 0 || (upper && cmp == 0))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return lo;
+}
+
+/**
+ * gm_device_index_get_names:
+ * @n_names:(out)(optional): The number of names
+ *
+ * Gets the names of all known devices, sorted by `strcmp()`.
+ *
+ * Returns:(transfer none): The `NULL` terminated names
+ */
+const char * const *
+gm_device_index_get_names (guint *n_names)
+{
+  const GmDeviceIndex *index = get_index ();
+
+  if (n_names)
+    *n_names = index->n_names;
+
+  return (const char * const *)index->names;
+}
+
+/**
+ * gm_device_index_find_prefix:
+ * @prefix: The prefix to look for
+ * @begin:(out): The first matching position
+ * @end:(out): The position after the last match
+ *
+ * Finds the range of names in the index starting with `prefix`. The
+ * range is empty if `begin` equals `end`.
+ */
+void
+gm_device_index_find_prefix (const char *prefix, guint *begin, guint *end)
+{
+  const GmDeviceIndex *index = get_index ();
+  gsize len = strlen (prefix);
+
+  *begin = bisect (index, prefix, len, FALSE);
+  *end = bisect (index, prefix, len, TRUE);
+}
+
+/**
+ * gm_device_index_contains:
+ * @name: The device name
+ *
+ * Checks whether a device of the given name is known.
+ *
+ * Returns: %TRUE if the device is in the index
+ */
+gboolean
+gm_device_index_contains (const char *name)
+{
+  const GmDeviceIndex *index = get_index ();
+  guint pos;
+
+  /* Compare the terminating NUL too so we only get exact matches */
+  pos = bisect (index, name, strlen (name) + 1, FALSE);
+
+  return pos < index->n_names && g_str_equal (index->names[pos], name);
+}
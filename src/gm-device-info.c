@@ -8,8 +8,16 @@
 
 #include "gm-config.h"
 
+#include "gm-device-index-private.h"
 #include "gm-device-info.h"
+#include "gm-device-patterns-private.h"
+#include "gm-device-tree.h"
 #include "gm-display-panel.h"
+#include "gm-dmi.h"
+#include "gm-drm-panel-private.h"
+#include "gm-stats-private.h"
+
+#include <gio/gio.h>
 
 #define GM_RESOURCE_PREFIX "/mobi/phosh/gmobile/"
 #define GM_DISPLAY_PANEL_RESOURCE_PREFIX GM_RESOURCE_PREFIX "devices/display-panels/"
@@ -23,7 +31,18 @@
  * sources (currently we only look a the built-in gresources).
  *
  * The lookups are currently based on device tree compatibles.
- * See [func@device_tree_get_compatibles].
+ * See [func@device_tree_get_compatibles]. Besides exact matches
+ * compatibles can also match patterns like `pine64,pinephone-1.*` so
+ * device variants can share data. On systems without a device tree
+ * (e.g. x86 tablets) [ctor@DeviceInfo.new_async] uses the DMI vendor
+ * and product name instead, see [func@dmi_get_compatible].
+ *
+ * If [property@DeviceInfo:sysfs-root] is set and there's no panel
+ * description for the device the built-in panel's EDID or preferred
+ * mode is used to get the display panel information.
+ *
+ * A device info can be shared between threads: its methods can be
+ * called concurrently and the display panel is only looked up once.
  *
  * Since: 0.0.1
  */
@@ -31,6 +50,7 @@
 enum {
   PROP_0,
   PROP_COMPATIBLES,
+  PROP_SYSFS_ROOT,
   PROP_LAST_PROP
 };
 static GParamSpec *props[PROP_LAST_PROP];
@@ -39,11 +59,61 @@ struct _GmDeviceInfo {
   GObject         parent;
 
   GStrv           compatibles;
+  char           *sysfs_root;
+  /* Set once via `panel_resolved`, NULL if no panel was found */
   GmDisplayPanel *panel;
+  gsize           panel_resolved;
 };
 G_DEFINE_TYPE (GmDeviceInfo, gm_device_info, G_TYPE_OBJECT)
 
 
+static GmDisplayPanel *
+find_display_panel (const char * const *compatibles, const char *sysfs_root)
+{
+  for (int i = 0; compatibles[i] != NULL; i++) {
+    g_autofree char *resource = NULL;
+    const char *name = compatibles[i];
+    GmDisplayPanel *panel;
+
+    /* Avoid resource lookups for devices we know nothing about */
+    if (!gm_device_index_contains (name)) {
+      name = gm_device_patterns_lookup (name);
+      if (name == NULL)
+        continue;
+    }
+
+    resource = g_strconcat (GM_DISPLAY_PANEL_RESOURCE_PREFIX, name, ".json", NULL);
+    panel = gm_display_panel_new_from_resource (resource, NULL);
+    if (panel)
+      return panel;
+  }
+
+  if (sysfs_root)
+    return gm_drm_panel_probe (sysfs_root);
+
+  return NULL;
+}
+
+
+/*
+ * Looks up the panel on first use. Concurrent callers block until the
+ * first one is done so the panel is only built once.
+ */
+static GmDisplayPanel *
+ensure_display_panel (GmDeviceInfo *self)
+{
+  if (g_once_init_enter (&self->panel_resolved)) {
+    /* Compatibles and sysfs root are construct only so safe to read here */
+    g_atomic_pointer_set (&self->panel,
+                          find_display_panel ((const char * const *)self->compatibles,
+                                              self->sysfs_root));
+    g_once_init_leave (&self->panel_resolved, TRUE);
+  }
+
+  return self->panel;
+}
+
+
 static void
 gm_device_info_set_property (GObject      *object,
                              guint         property_id,
@@ -57,6 +127,10 @@ gm_device_info_set_property (GObject      *object,
     g_strfreev (self->compatibles);
     self->compatibles = g_value_dup_boxed (value);
     break;
+  case PROP_SYSFS_ROOT:
+    g_free (self->sysfs_root);
+    self->sysfs_root = g_value_dup_string (value);
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
     break;
@@ -76,6 +150,9 @@ gm_device_info_get_property (GObject    *object,
   case PROP_COMPATIBLES:
     g_value_set_boxed (value, self->compatibles);
     break;
+  case PROP_SYSFS_ROOT:
+    g_value_set_string (value, self->sysfs_root);
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
     break;
@@ -90,6 +167,9 @@ gm_device_info_finalize (GObject *object)
 
   g_clear_object (&self->panel);
   g_clear_pointer (&self->compatibles, g_strfreev);
+  g_clear_pointer (&self->sysfs_root, g_free);
+
+  gm_stats_object_removed (GM_STATS_OBJECT_DEVICE_INFO, sizeof (GmDeviceInfo));
 
   G_OBJECT_CLASS (gm_device_info_parent_class)->finalize (object);
 }
@@ -116,6 +196,19 @@ gm_device_info_class_init (GmDeviceInfoClass *klass)
                         G_TYPE_STRV,
                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
 
+  /**
+   * GmDeviceInfo:sysfs-root:
+   *
+   * Where sysfs is mounted. If set, the DRM connectors found there are
+   * used as fallback when looking up display panel information.
+   *
+   * Since: 0.8.0
+   */
+  props[PROP_SYSFS_ROOT] =
+    g_param_spec_string ("sysfs-root", "", "",
+                         NULL,
+                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+
   g_object_class_install_properties (object_class, PROP_LAST_PROP, props);
 }
 
@@ -123,6 +216,7 @@ gm_device_info_class_init (GmDeviceInfoClass *klass)
 static void
 gm_device_info_init (GmDeviceInfo *self)
 {
+  gm_stats_object_added (GM_STATS_OBJECT_DEVICE_INFO, sizeof (GmDeviceInfo));
 }
 
 /**
@@ -150,6 +244,10 @@ gm_device_info_new (const char * const compatibles[])
  * Gets display panel information. Queries the database for the best
  * matching panel based on the device's compatibles.
  *
+ * The result is kept so only the first call does the lookup. This
+ * function is thread safe: callers racing with the first lookup wait
+ * for it and get the same panel.
+ *
  * Returns:(transfer none): The display panel information
  *
  * Since: 0.0.1
@@ -157,25 +255,258 @@ gm_device_info_new (const char * const compatibles[])
 GmDisplayPanel *
 gm_device_info_get_display_panel (GmDeviceInfo *self)
 {
-  GmDisplayPanel *panel = NULL;
-
   g_return_val_if_fail (GM_IS_DEVICE_INFO (self), NULL);
   g_return_val_if_fail (self->compatibles, NULL);
 
-  if (self->panel)
-    return self->panel;
+  return ensure_display_panel (self);
+}
 
-  for (int i = 0; self->compatibles[i] != NULL; i++) {
-    g_autofree char *filename = g_strdup_printf ("%s.json", self->compatibles[i]);
-    g_autofree char *resource = NULL;
+/**
+ * gm_device_info_lookup_panel_geometries:
+ * @compatibles:(array zero-terminated=1): device tree compatibles
+ *
+ * Looks up the display panels of many devices at once. Unlike
+ * [method@DeviceInfo.get_display_panel] each compatible is treated as
+ * a separate device. This is meant for language bindings that want to
+ * process e.g. all of [func@list_devices] without a call per property
+ * and panel.
+ *
+ * The result is a dictionary of type `a{s(siiii(iiii)a(s(iiii)s))}`
+ * mapping each compatible to its panel's geometry as described in
+ * [method@DisplayPanel.get_geometry]. Compatibles without a panel are
+ * left out.
+ *
+ * Returns:(transfer full): The panel geometries
+ *
+ * Since: 0.8.0
+ */
+GVariant *
+gm_device_info_lookup_panel_geometries (const char * const *compatibles)
+{
+  GVariantBuilder builder;
 
-    resource = g_build_path ("/", GM_DISPLAY_PANEL_RESOURCE_PREFIX, filename, NULL);
-    panel = gm_display_panel_new_from_resource (resource, NULL);
-    if (panel) {
-      self->panel = panel;
-      break;
-    }
+  g_return_val_if_fail (compatibles, NULL);
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{s" GM_DISPLAY_PANEL_GEOMETRY_FORMAT "}"));
+  for (int i = 0; compatibles[i] != NULL; i++) {
+    const char *const compatible[] = { compatibles[i], NULL };
+    g_autoptr (GmDisplayPanel) panel = NULL;
+    g_autoptr (GVariant) geometry = NULL;
+
+    panel = find_display_panel (compatible, NULL);
+    if (panel == NULL)
+      continue;
+
+    geometry = gm_display_panel_get_geometry (panel);
+    g_variant_builder_add (&builder, "{s@" GM_DISPLAY_PANEL_GEOMETRY_FORMAT "}",
+                           compatibles[i], geometry);
   }
 
-  return self->panel;
+  return g_variant_ref_sink (g_variant_builder_end (&builder));
+}
+
+
+/*
+ * The device tree compatibles followed by the compatible built from
+ * DMI data. Usually only one of them is available.
+ */
+static GStrv
+get_system_compatibles (const char *sysfs_root, GError **err)
+{
+  g_autoptr (GmDeviceTreeCompatibles) dt_compatibles = NULL;
+  g_autoptr (GStrvBuilder) builder = g_strv_builder_new ();
+  g_autoptr (GError) dt_err = NULL;
+  char *dmi_compatible;
+
+  dt_compatibles = gm_device_tree_get_cached_compatibles (sysfs_root, &dt_err);
+  if (dt_compatibles) {
+    g_strv_builder_addv (builder,
+                         (const char **)gm_device_tree_compatibles_get_strv (dt_compatibles,
+                                                                             NULL));
+  }
+
+  dmi_compatible = gm_dmi_get_compatible (sysfs_root, NULL);
+  if (dmi_compatible)
+    g_strv_builder_take (builder, dmi_compatible);
+
+  if (dt_compatibles == NULL && dmi_compatible == NULL) {
+    g_propagate_error (err, g_steal_pointer (&dt_err));
+    return NULL;
+  }
+
+  return g_strv_builder_end (builder);
+}
+
+
+static void
+new_thread (GTask        *task,
+            gpointer      source_object,
+            gpointer      task_data,
+            GCancellable *cancellable)
+{
+  const char *sysfs_root = task_data;
+  g_autoptr (GError) err = NULL;
+  g_auto (GStrv) compatibles = NULL;
+
+  if (g_task_return_error_if_cancelled (task))
+    return;
+
+  compatibles = get_system_compatibles (sysfs_root, &err);
+  if (compatibles == NULL) {
+    g_task_return_error (task, g_steal_pointer (&err));
+    return;
+  }
+
+  g_task_return_pointer (task,
+                         g_object_new (GM_TYPE_DEVICE_INFO,
+                                       "compatibles", compatibles,
+                                       "sysfs-root", sysfs_root ?: "/sys",
+                                       NULL),
+                         g_object_unref);
+}
+
+/**
+ * gm_device_info_new_async:
+ * @sysfs_root:(nullable): Path where /sys is mounted. Defaults to `/sys` if %NULL is passed.
+ * @cancellable:(nullable): A cancellable
+ * @callback: The callback to invoke when done
+ * @user_data: The user data for the callback
+ *
+ * Asynchronously gets device information for the running system. The
+ * device tree compatibles (see [func@device_tree_get_cached_compatibles])
+ * and DMI data (see [func@dmi_get_compatible]) are read on a worker
+ * thread so this doesn't block the calling thread. `callback` is
+ * invoked in the thread-default main context of the caller.
+ *
+ * The returned object has [property@DeviceInfo:sysfs-root] set.
+ *
+ * Since: 0.8.0
+ */
+void
+gm_device_info_new_async (const char          *sysfs_root,
+                          GCancellable        *cancellable,
+                          GAsyncReadyCallback  callback,
+                          gpointer             user_data)
+{
+  g_autoptr (GTask) task = NULL;
+
+  g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+
+  task = g_task_new (NULL, cancellable, callback, user_data);
+  g_task_set_source_tag (task, gm_device_info_new_async);
+  g_task_set_task_data (task, g_strdup (sysfs_root), g_free);
+  g_task_run_in_thread (task, new_thread);
+}
+
+/**
+ * gm_device_info_new_finish:
+ * @res: The result
+ * @err: Return location for an error
+ *
+ * Finishes an operation started by [func@DeviceInfo.new_async].
+ * On error `NULL` is returned and `err` is set.
+ *
+ * Returns:(transfer full): The device information
+ *
+ * Since: 0.8.0
+ */
+GmDeviceInfo *
+gm_device_info_new_finish (GAsyncResult *res, GError **err)
+{
+  g_return_val_if_fail (g_task_is_valid (res, NULL), NULL);
+  g_return_val_if_fail (g_task_get_source_tag (G_TASK (res)) == gm_device_info_new_async, NULL);
+
+  return g_task_propagate_pointer (G_TASK (res), err);
+}
+
+
+static void
+get_display_panel_thread (GTask        *task,
+                          gpointer      source_object,
+                          gpointer      task_data,
+                          GCancellable *cancellable)
+{
+  GmDeviceInfo *self = GM_DEVICE_INFO (source_object);
+  GmDisplayPanel *panel;
+
+  if (g_task_return_error_if_cancelled (task))
+    return;
+
+  panel = ensure_display_panel (self);
+  if (panel == NULL) {
+    g_task_return_new_error (task, G_IO_ERROR, G_IO_ERROR_NOT_FOUND,
+                             "No display panel found");
+    return;
+  }
+
+  g_task_return_pointer (task, g_object_ref (panel), g_object_unref);
+}
+
+/**
+ * gm_device_info_get_display_panel_async:
+ * @self: The device info
+ * @cancellable:(nullable): A cancellable
+ * @callback: The callback to invoke when done
+ * @user_data: The user data for the callback
+ *
+ * Asynchronously gets display panel information. The panel data
+ * is looked up and parsed on a worker thread. `callback` is invoked
+ * in the thread-default main context of the caller. See
+ * [method@DeviceInfo.get_display_panel].
+ *
+ * Since: 0.8.0
+ */
+void
+gm_device_info_get_display_panel_async (GmDeviceInfo        *self,
+                                        GCancellable        *cancellable,
+                                        GAsyncReadyCallback  callback,
+                                        gpointer             user_data)
+{
+  g_autoptr (GTask) task = NULL;
+  GmDisplayPanel *panel;
+
+  g_return_if_fail (GM_IS_DEVICE_INFO (self));
+  g_return_if_fail (self->compatibles);
+  g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+
+  task = g_task_new (self, cancellable, callback, user_data);
+  g_task_set_source_tag (task, gm_device_info_get_display_panel_async);
+
+  panel = g_atomic_pointer_get (&self->panel);
+  if (panel) {
+    g_task_return_pointer (task, g_object_ref (panel), g_object_unref);
+    return;
+  }
+
+  g_task_run_in_thread (task, get_display_panel_thread);
+}
+
+/**
+ * gm_device_info_get_display_panel_finish:
+ * @self: The device info
+ * @res: The result
+ * @err: Return location for an error
+ *
+ * Finishes an operation started by
+ * [method@DeviceInfo.get_display_panel_async]. If no panel could be
+ * found `NULL` is returned and `err` is set.
+ *
+ * Returns:(transfer none): The display panel information
+ *
+ * Since: 0.8.0
+ */
+GmDisplayPanel *
+gm_device_info_get_display_panel_finish (GmDeviceInfo *self, GAsyncResult *res, GError **err)
+{
+  g_autoptr (GmDisplayPanel) panel = NULL;
+
+  g_return_val_if_fail (GM_IS_DEVICE_INFO (self), NULL);
+  g_return_val_if_fail (g_task_is_valid (res, self), NULL);
+
+  panel = g_task_propagate_pointer (G_TASK (res), err);
+  if (panel == NULL)
+    return NULL;
+
+  /* The device info holds a reference too */
+  return ensure_display_panel (self);
 }
@@ -10,7 +10,7 @@
 
 #include "gm-display-panel.h"
 
-#include <glib-object.h>
+#include <gio/gio.h>
 
 G_BEGIN_DECLS
 
@@ -19,6 +19,19 @@ G_BEGIN_DECLS
 G_DECLARE_FINAL_TYPE (GmDeviceInfo, gm_device_info, GM, DEVICE_INFO, GObject)
 
 GmDeviceInfo    *gm_device_info_new (const char * const compatibles[]);
+void             gm_device_info_new_async (const char          *sysfs_root,
+                                           GCancellable        *cancellable,
+                                           GAsyncReadyCallback  callback,
+                                           gpointer             user_data);
+GmDeviceInfo    *gm_device_info_new_finish (GAsyncResult *res, GError **err);
 GmDisplayPanel  *gm_device_info_get_display_panel (GmDeviceInfo *self);
+GVariant        *gm_device_info_lookup_panel_geometries (const char * const *compatibles);
+void             gm_device_info_get_display_panel_async (GmDeviceInfo        *self,
+                                                         GCancellable        *cancellable,
+                                                         GAsyncReadyCallback  callback,
+                                                         gpointer             user_data);
+GmDisplayPanel  *gm_device_info_get_display_panel_finish (GmDeviceInfo  *self,
+                                                          GAsyncResult  *res,
+                                                          GError       **err);
 
 G_END_DECLS
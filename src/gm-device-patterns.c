@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "gm-device-patterns-private.h"
+
+/*
+ * A trie node. The children of a node are stored next to each other
+ * sorted by their character. Targets index into `pattern_targets`,
+ * -1 if the node doesn't end a pattern.
+ */
+typedef struct {
+  char    c;
+  guint16 first_child;
+  guint16 n_children;
+  gint16  prefix_target;
+  gint16  exact_target;
+} GmPatternNode;
+
+/* Generated at build time from data/devices/display-panel-patterns.txt */
+#include "gm-panel-patterns.h"
+
+
+static const GmPatternNode *
+find_child (const GmPatternNode *node, char c)
+{
+  guint lo = node->first_child, hi = node->first_child + node->n_children;
+
+  while (lo < hi) {
+    guint mid = lo + (hi - lo) / 2;
+
+    if (pattern_nodes[mid].c == c)
+      return &pattern_nodes[mid];
+
+    if (pattern_nodes[mid].c < c)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return NULL;
+}
+
+/**
+ * gm_device_patterns_lookup:
+ * @compatible: A device tree compatible
+ *
+ * Looks up the panel description for `compatible` in the compatible
+ * patterns. The longest matching pattern wins. This only needs a
+ * single pass over `compatible`.
+ *
+ * Returns:(nullable): The name of the matching panel description
+ */
+const char *
+gm_device_patterns_lookup (const char *compatible)
+{
+  const GmPatternNode *node = &pattern_nodes[0];
+  int target = -1;
+
+  g_return_val_if_fail (compatible != NULL, NULL);
+
+  for (const char *p = compatible; *p; p++) {
+    node = find_child (node, *p);
+    if (node == NULL)
+      break;
+
+    if (node->prefix_target >= 0)
+      target = node->prefix_target;
+  }
+
+  if (node && node->exact_target >= 0)
+    target = node->exact_target;
+
+  return target >= 0 ? pattern_targets[target] : NULL;
+}
@@ -7,21 +7,143 @@
  */
 
 #include "gm-device-tree.h"
+#include "gm-stats-private.h"
+#include "gm-trace-private.h"
 
 #include <gio/gio.h>
 #include <glib.h>
 
-#define DT_COMPATIBLE_PATH "firmware/devicetree/base/compatible"
+#ifdef __linux__
+# include <errno.h>
+# include <fcntl.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
 
-static GStrv
+#define DT_BASE_PATH "firmware/devicetree/base"
+#define DT_COMPATIBLE_PATH DT_BASE_PATH "/compatible"
+#define DEFAULT_SYSFS_ROOT "/sys"
+
+/**
+ * GmDeviceTreeCompatibles:
+ *
+ * A reference counted, immutable list of device tree compatibles. All
+ * strings point into a single buffer holding the data as read from
+ * the device tree.
+ *
+ * See [func@device_tree_get_cached_compatibles].
+ *
+ * Since: 0.8.0
+ */
+struct _GmDeviceTreeCompatibles {
+  char       *buffer;
+  guint       n_compatibles;
+  const char *compatibles[];
+};
+
+G_DEFINE_BOXED_TYPE (GmDeviceTreeCompatibles,
+                     gm_device_tree_compatibles,
+                     gm_device_tree_compatibles_ref,
+                     gm_device_tree_compatibles_unref)
+
+typedef struct {
+  GmDeviceTreeCompatibles *compatibles;
+  GError                  *error;
+} CacheEntry;
+
+G_LOCK_DEFINE_STATIC (cache);
+static GHashTable *cache;
+
+
+static void
+cache_entry_free (gpointer data)
+{
+  CacheEntry *entry = data;
+
+  g_clear_pointer (&entry->compatibles, gm_device_tree_compatibles_unref);
+  g_clear_error (&entry->error);
+  g_free (entry);
+}
+
+/* Takes ownership of `buffer`, a list of `len` bytes of NUL separated strings */
+static GmDeviceTreeCompatibles *
+compatibles_new_take (char *buffer, gsize len)
+{
+  GmDeviceTreeCompatibles *self;
+  const char *comp;
+  guint n = 0;
+
+  for (gsize i = 0; i < len; i++) {
+    if (buffer[i] == '\0' || i == len - 1)
+      n++;
+  }
+
+  self = g_atomic_rc_box_alloc (sizeof (GmDeviceTreeCompatibles) + (n + 1) * sizeof (char *));
+  self->buffer = buffer;
+  self->n_compatibles = n;
+
+  comp = buffer;
+  for (guint i = 0; i < n; i++) {
+    self->compatibles[i] = comp;
+    comp = strchr (comp, 0);
+    comp++;
+  }
+  self->compatibles[n] = NULL;
+
+  return self;
+}
+
+
+static GmDeviceTreeCompatibles *
 get_env_compatibles (void)
 {
   const char *env = g_getenv ("GMOBILE_DT_COMPATIBLES");
+  char *buffer;
+  gsize len;
+
+  if (env == NULL)
+    return NULL;
+
+  len = strlen (env);
+  buffer = g_strndup (env, len);
+  g_strdelimit (buffer, ":", '\0');
+
+  return compatibles_new_take (buffer, len);
+}
+
 
-  if (env)
-    return g_strsplit(env, ":", -1);
+static GmDeviceTreeCompatibles *
+read_compatibles (const char *sysfs_root, GError **err)
+{
+#ifdef __linux__
+  g_autofree char *compatible_path = NULL;
+  g_autoptr (GError) local_err = NULL;
+  gint64 begin = GM_TRACE_CURRENT_TIME;
+  gboolean success;
+  char *contents;
+  gsize len;
 
+  compatible_path = g_build_filename (sysfs_root ?: DEFAULT_SYSFS_ROOT,
+                                      DT_COMPATIBLE_PATH, NULL);
+
+  success = g_file_get_contents (compatible_path, &contents, &len, &local_err);
+  GM_TRACE_MARK (begin, "read-compatibles", "%s", compatible_path);
+  if (!success) {
+    if (g_error_matches (local_err, G_FILE_ERROR, G_FILE_ERROR_NOENT)) {
+      g_set_error (err, G_IO_ERROR, G_IO_ERROR_NOT_FOUND,
+                   "%s not found", compatible_path);
+    } else {
+      g_propagate_error (err, g_steal_pointer (&local_err));
+    }
+    return NULL;
+  }
+
+  return compatibles_new_take (contents, len);
+#else
+  g_set_error_literal (err, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                       "Not supported on this platform");
   return NULL;
+#endif
 }
 
 /**
@@ -36,6 +158,9 @@ get_env_compatibles (void)
  * For debugging purposes `GMOBILE_DT_COMPATIBLES` can be set to a `:`
  * separated list of compatibles which will be returned instead.
  *
+ * The compatibles are read on every call. Use
+ * [func@device_tree_get_cached_compatibles] to avoid that.
+ *
  * Returns:(transfer full): compatible machine types or %NULL
  *
  * Since: 0.0.1
@@ -43,48 +168,565 @@ get_env_compatibles (void)
 GStrv
 gm_device_tree_get_compatibles (const char *sysfs_root, GError **err)
 {
-  GStrv env_compatibles;
-#ifdef __linux__
-  gsize len;
-  g_autoptr (GPtrArray) parts = NULL;
-  g_autofree char *compatible_path = NULL;
-  g_autofree gchar *compatibles = NULL;
-  const char *comp;
+  g_autoptr (GmDeviceTreeCompatibles) compatibles = NULL;
 
   g_return_val_if_fail (err == NULL || *err == NULL, NULL);
 
-  env_compatibles = get_env_compatibles();
-  if (env_compatibles)
-    return env_compatibles;
+  compatibles = get_env_compatibles ();
+  if (compatibles == NULL)
+    compatibles = read_compatibles (sysfs_root, err);
 
-  compatible_path = g_build_filename (sysfs_root ?: "/sys",
-                                      DT_COMPATIBLE_PATH, NULL);
-  if (g_file_test (compatible_path, (G_FILE_TEST_EXISTS)) == FALSE) {
-    g_set_error (err, G_IO_ERROR, G_IO_ERROR_NOT_FOUND,
-                 "%s not found", compatible_path);
+  if (compatibles == NULL)
     return NULL;
+
+  return g_strdupv ((GStrv)compatibles->compatibles);
+}
+
+/**
+ * gm_device_tree_get_cached_compatibles:
+ * @sysfs_root:(nullable): Path where /sys is mounted. Defaults to `/sys` if %NULL is passed.
+ * @err: return location for error or %NULL
+ *
+ * Like [func@device_tree_get_compatibles] but the compatibles are only
+ * read once per `sysfs_root` and then kept until [func@trim] is
+ * called. Errors are remembered too. Use
+ * [func@device_tree_invalidate_compatibles] to drop the cached result.
+ *
+ * If `GMOBILE_DT_COMPATIBLES` is set its value is returned and not
+ * cached.
+ *
+ * This function is thread safe.
+ *
+ * Returns:(transfer full)(nullable): The compatibles or %NULL on error
+ *
+ * Since: 0.8.0
+ */
+GmDeviceTreeCompatibles *
+gm_device_tree_get_cached_compatibles (const char *sysfs_root, GError **err)
+{
+  GmDeviceTreeCompatibles *compatibles;
+  CacheEntry *entry;
+
+  g_return_val_if_fail (err == NULL || *err == NULL, NULL);
+
+  compatibles = get_env_compatibles ();
+  if (compatibles)
+    return compatibles;
+
+  sysfs_root = sysfs_root ?: DEFAULT_SYSFS_ROOT;
+
+  G_LOCK (cache);
+
+  if (cache == NULL)
+    cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, cache_entry_free);
+
+  entry = g_hash_table_lookup (cache, sysfs_root);
+  if (entry == NULL) {
+    entry = g_new0 (CacheEntry, 1);
+    entry->compatibles = read_compatibles (sysfs_root, &entry->error);
+    g_hash_table_insert (cache, g_strdup (sysfs_root), entry);
   }
 
-  if (!g_file_get_contents (compatible_path, &compatibles, &len, err)) {
-    return NULL;
+  if (entry->compatibles)
+    compatibles = gm_device_tree_compatibles_ref (entry->compatibles);
+  else
+    g_propagate_error (err, g_error_copy (entry->error));
+
+  G_UNLOCK (cache);
+
+  return compatibles;
+}
+
+/**
+ * gm_device_tree_invalidate_compatibles:
+ * @sysfs_root:(nullable): Path where /sys is mounted. Defaults to `/sys` if %NULL is passed.
+ *
+ * Drops the compatibles cached for `sysfs_root` so the next call to
+ * [func@device_tree_get_cached_compatibles] reads them again. References
+ * to previously returned compatibles stay valid.
+ *
+ * Since: 0.8.0
+ */
+void
+gm_device_tree_invalidate_compatibles (const char *sysfs_root)
+{
+  G_LOCK (cache);
+  if (cache)
+    g_hash_table_remove (cache, sysfs_root ?: DEFAULT_SYSFS_ROOT);
+  G_UNLOCK (cache);
+}
+
+
+guint
+gm_device_tree_get_cache_stats (gsize *size)
+{
+  GHashTableIter iter;
+  gpointer key, value;
+  guint n = 0;
+
+  *size = 0;
+
+  G_LOCK (cache);
+  if (cache) {
+    g_hash_table_iter_init (&iter, cache);
+    while (g_hash_table_iter_next (&iter, &key, &value)) {
+      CacheEntry *entry = value;
+
+      *size += sizeof (CacheEntry) + strlen (key) + 1;
+      if (entry->compatibles) {
+        GmDeviceTreeCompatibles *compatibles = entry->compatibles;
+
+        *size += sizeof (GmDeviceTreeCompatibles) +
+          (compatibles->n_compatibles + 1) * sizeof (char *);
+        for (guint i = 0; i < compatibles->n_compatibles; i++)
+          *size += strlen (compatibles->compatibles[i]) + 1;
+      }
+      if (entry->error)
+        *size += sizeof (GError) + strlen (entry->error->message) + 1;
+      n++;
+    }
   }
+  G_UNLOCK (cache);
+
+  return n;
+}
+
+
+void
+gm_device_tree_trim_cache (void)
+{
+  G_LOCK (cache);
+  g_clear_pointer (&cache, g_hash_table_destroy);
+  G_UNLOCK (cache);
+}
+
+
+/**
+ * gm_device_tree_compatibles_ref:
+ * @self: The compatibles
+ *
+ * Acquires a reference.
+ *
+ * Returns:(transfer full): The compatibles
+ *
+ * Since: 0.8.0
+ */
+GmDeviceTreeCompatibles *
+gm_device_tree_compatibles_ref (GmDeviceTreeCompatibles *self)
+{
+  g_return_val_if_fail (self != NULL, NULL);
+
+  return g_atomic_rc_box_acquire (self);
+}
+
+
+static void
+compatibles_clear (gpointer data)
+{
+  GmDeviceTreeCompatibles *self = data;
+
+  g_free (self->buffer);
+}
+
+/**
+ * gm_device_tree_compatibles_unref:
+ * @self: The compatibles
+ *
+ * Releases a reference. When the last reference is dropped the
+ * compatibles are freed.
+ *
+ * Since: 0.8.0
+ */
+void
+gm_device_tree_compatibles_unref (GmDeviceTreeCompatibles *self)
+{
+  g_return_if_fail (self != NULL);
+
+  g_atomic_rc_box_release_full (self, compatibles_clear);
+}
+
+/**
+ * gm_device_tree_compatibles_get_strv:
+ * @self: The compatibles
+ * @n_compatibles:(out)(optional): The number of compatibles
+ *
+ * Gets the compatibles, most specific first.
+ *
+ * Returns:(transfer none)(array zero-terminated=1): The compatibles. Valid as long
+ *   as `self` is.
+ *
+ * Since: 0.8.0
+ */
+const char * const *
+gm_device_tree_compatibles_get_strv (GmDeviceTreeCompatibles *self, guint *n_compatibles)
+{
+  g_return_val_if_fail (self != NULL, NULL);
 
-  parts = g_ptr_array_new ();
-  comp = compatibles;
-  while (comp - compatibles < len) {
-    g_ptr_array_add (parts, (gpointer) g_strdup (comp));
+  if (n_compatibles)
+    *n_compatibles = self->n_compatibles;
+
+  return self->compatibles;
+}
+
+
+static GStrv
+split_strings (const char *buffer, gsize len)
+{
+  g_autoptr (GPtrArray) parts = g_ptr_array_new ();
+  const char *comp = buffer;
+
+  /* `buffer` is NUL terminated even if the last string isn't */
+  while (comp - buffer < len) {
+    g_ptr_array_add (parts, g_strdup (comp));
     comp = strchr (comp, 0);
     comp++;
   }
   g_ptr_array_add (parts, NULL);
+
   return (GStrv) g_ptr_array_steal (parts, NULL);
+}
+
+
+static gboolean
+parse_property (GmDeviceTreeProperty *property, const char *buffer, gsize len, GError **err)
+{
+  switch (property->type) {
+  case GM_DEVICE_TREE_PROPERTY_STRINGS:
+    property->strings = split_strings (buffer, len);
+    break;
+  case GM_DEVICE_TREE_PROPERTY_U32_ARRAY:
+    if (len % sizeof (guint32)) {
+      g_set_error (err, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                   "Property '%s' has invalid length %" G_GSIZE_FORMAT " for u32 cells",
+                   property->name, len);
+      return FALSE;
+    }
+    property->n_values = len / sizeof (guint32);
+    property->values = g_new (guint32, property->n_values);
+    for (gsize i = 0; i < property->n_values; i++) {
+      guint32 be;
+
+      memcpy (&be, buffer + i * sizeof (guint32), sizeof (guint32));
+      property->values[i] = GUINT32_FROM_BE (be);
+    }
+    break;
+  case GM_DEVICE_TREE_PROPERTY_BOOLEAN:
+    break;
+  default:
+    g_assert_not_reached ();
+  }
+
+  property->found = TRUE;
+  return TRUE;
+}
+
+/* The GMOBILE_DT_COMPATIBLES override for the root node's compatible */
+static gboolean
+get_env_property (const char *node, GmDeviceTreeProperty *property)
+{
+  g_autoptr (GmDeviceTreeCompatibles) compatibles = NULL;
+
+  if (!g_str_equal (node, "") || !g_str_equal (property->name, "compatible"))
+    return FALSE;
+
+  compatibles = get_env_compatibles ();
+  if (compatibles == NULL)
+    return FALSE;
+
+  property->found = TRUE;
+  if (property->type == GM_DEVICE_TREE_PROPERTY_STRINGS)
+    property->strings = g_strdupv ((GStrv)compatibles->compatibles);
+
+  return TRUE;
+}
+
+#ifdef __linux__
+
+static gboolean
+read_property_at (int                    dirfd,
+                  GmDeviceTreeProperty  *property,
+                  GError               **err)
+{
+  g_autofree char *buffer = NULL;
+  gsize len = 0, size = 256;
+  int fd;
+
+  if (property->type == GM_DEVICE_TREE_PROPERTY_BOOLEAN) {
+    struct stat st;
+
+    property->found = fstatat (dirfd, property->name, &st, 0) == 0;
+    return TRUE;
+  }
+
+  fd = openat (dirfd, property->name, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    int saved_errno = errno;
+
+    if (saved_errno == ENOENT)
+      return TRUE;
+
+    g_set_error (err, G_IO_ERROR, g_io_error_from_errno (saved_errno),
+                 "Failed to open '%s': %s", property->name, g_strerror (saved_errno));
+    return FALSE;
+  }
+
+  buffer = g_malloc (size);
+  while (TRUE) {
+    gssize ret;
+
+    /* Keep room for the terminating NUL */
+    if (len + 1 >= size) {
+      size *= 2;
+      buffer = g_realloc (buffer, size);
+    }
+
+    ret = read (fd, buffer + len, size - len - 1);
+    if (ret < 0) {
+      int saved_errno = errno;
+
+      if (saved_errno == EINTR)
+        continue;
+
+      close (fd);
+      g_set_error (err, G_IO_ERROR, g_io_error_from_errno (saved_errno),
+                   "Failed to read '%s': %s", property->name, g_strerror (saved_errno));
+      return FALSE;
+    }
+    if (ret == 0)
+      break;
+    len += ret;
+  }
+  close (fd);
+  buffer[len] = '\0';
+
+  return parse_property (property, buffer, len, err);
+}
+
+#endif
+
+/**
+ * gm_device_tree_property_clear:
+ * @property: The property
+ *
+ * Frees the data read into `property` and resets the output fields.
+ * `name` and `type` are left alone so `property` can be reused.
+ *
+ * Since: 0.8.0
+ */
+void
+gm_device_tree_property_clear (GmDeviceTreeProperty *property)
+{
+  g_return_if_fail (property != NULL);
+
+  property->found = FALSE;
+  g_clear_pointer (&property->strings, g_strfreev);
+  g_clear_pointer (&property->values, g_free);
+  property->n_values = 0;
+}
+
+/**
+ * gm_device_tree_read_properties:
+ * @sysfs_root:(nullable): Path where /sys is mounted. Defaults to `/sys` if %NULL is passed.
+ * @node: The path of the device tree node, e.g. `/` or `/panel`
+ * @properties:(array length=n_properties): The properties to read
+ * @n_properties: The number of properties
+ * @err: return location for error or %NULL
+ *
+ * Reads several properties of a device tree node from
+ * `sysfs_root/firmware/devicetree/base/` at once. The node's directory is
+ * only looked up once and each property is then read relative to it.
+ *
+ * Properties that don't exist have `found` set to `FALSE`, this is not
+ * an error. If `GMOBILE_DT_COMPATIBLES` is set it's used for the root
+ * node's `compatible` property, see [func@device_tree_get_compatibles].
+ *
+ * On error all properties are cleared.
+ *
+ * Returns: %TRUE if the node could be read, otherwise %FALSE
+ *
+ * Since: 0.8.0
+ */
+gboolean
+gm_device_tree_read_properties (const char            *sysfs_root,
+                                const char            *node,
+                                GmDeviceTreeProperty  *properties,
+                                guint                  n_properties,
+                                GError               **err)
+{
+  g_autoptr (GError) local_err = NULL;
+#ifdef __linux__
+  g_autofree char *node_path = NULL;
+  int dirfd = -1;
+#endif
+  gint64 begin = GM_TRACE_CURRENT_TIME;
+  guint i;
+
+  g_return_val_if_fail (node != NULL, FALSE);
+  g_return_val_if_fail (properties != NULL || n_properties == 0, FALSE);
+  g_return_val_if_fail (err == NULL || *err == NULL, FALSE);
+
+  for (i = 0; i < n_properties; i++)
+    g_return_val_if_fail (properties[i].name != NULL, FALSE);
+
+  while (node[0] == '/')
+    node++;
+
+  for (i = 0; i < n_properties; i++) {
+    GmDeviceTreeProperty *property = &properties[i];
+
+    property->found = FALSE;
+    property->strings = NULL;
+    property->values = NULL;
+    property->n_values = 0;
+
+    if (get_env_property (node, property))
+      continue;
+
+#ifdef __linux__
+    /* Only look up the node if we need it */
+    if (dirfd < 0) {
+      node_path = g_build_filename (sysfs_root ?: DEFAULT_SYSFS_ROOT, DT_BASE_PATH, node, NULL);
+      dirfd = open (node_path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+      if (dirfd < 0) {
+        int saved_errno = errno;
+
+        g_set_error (&local_err, G_IO_ERROR, g_io_error_from_errno (saved_errno),
+                     "Failed to open %s: %s", node_path, g_strerror (saved_errno));
+        break;
+      }
+    }
+
+    if (!read_property_at (dirfd, property, &local_err))
+      break;
 #else
-  env_compatibles = get_env_compatibles();
-  if (env_compatibles)
-    return env_compatibles;
+    g_set_error_literal (&local_err, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                         "Not supported on this platform");
+    break;
+#endif
+  }
 
-  g_set_error_literal (err, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
-                       "Not supported on this platform");
-  return NULL;
+#ifdef __linux__
+  if (dirfd >= 0)
+    close (dirfd);
 #endif
+
+  GM_TRACE_MARK (begin, "read-properties", "%s: %u properties", node, n_properties);
+
+  if (local_err) {
+    for (guint j = 0; j <= i && j < n_properties; j++)
+      gm_device_tree_property_clear (&properties[j]);
+
+    g_propagate_error (err, g_steal_pointer (&local_err));
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+
+static gboolean
+read_single_property (const char            *sysfs_root,
+                      const char            *node,
+                      GmDeviceTreeProperty  *property,
+                      GError               **err)
+{
+  if (!gm_device_tree_read_properties (sysfs_root, node, property, 1, err))
+    return FALSE;
+
+  if (!property->found) {
+    g_set_error (err, G_IO_ERROR, G_IO_ERROR_NOT_FOUND,
+                 "Property '%s' of node '%s' not found", property->name, node);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * gm_device_tree_read_strings:
+ * @sysfs_root:(nullable): Path where /sys is mounted. Defaults to `/sys` if %NULL is passed.
+ * @node: The path of the device tree node, e.g. `/`
+ * @name: The property's name, e.g. `model`
+ * @err: return location for error or %NULL
+ *
+ * Reads a property holding a list of strings. See
+ * [func@device_tree_read_properties] to read several properties at once.
+ *
+ * Returns:(transfer full)(nullable): The strings or %NULL on error
+ *
+ * Since: 0.8.0
+ */
+GStrv
+gm_device_tree_read_strings (const char  *sysfs_root,
+                             const char  *node,
+                             const char  *name,
+                             GError     **err)
+{
+  GmDeviceTreeProperty property = { .name = name, .type = GM_DEVICE_TREE_PROPERTY_STRINGS };
+
+  g_return_val_if_fail (name != NULL, NULL);
+
+  if (!read_single_property (sysfs_root, node, &property, err))
+    return NULL;
+
+  return property.strings;
+}
+
+/**
+ * gm_device_tree_read_u32_array:
+ * @sysfs_root:(nullable): Path where /sys is mounted. Defaults to `/sys` if %NULL is passed.
+ * @node: The path of the device tree node, e.g. `/panel`
+ * @name: The property's name, e.g. `width-mm`
+ * @n_values:(out)(optional): The number of values
+ * @err: return location for error or %NULL
+ *
+ * Reads a property holding an array of big endian 32 bit cells and
+ * returns them in host byte order.
+ *
+ * Returns:(transfer full)(nullable)(array length=n_values): The values
+ *   or %NULL on error
+ *
+ * Since: 0.8.0
+ */
+guint32 *
+gm_device_tree_read_u32_array (const char  *sysfs_root,
+                               const char  *node,
+                               const char  *name,
+                               gsize       *n_values,
+                               GError     **err)
+{
+  GmDeviceTreeProperty property = { .name = name, .type = GM_DEVICE_TREE_PROPERTY_U32_ARRAY };
+
+  g_return_val_if_fail (name != NULL, NULL);
+
+  if (!read_single_property (sysfs_root, node, &property, err))
+    return NULL;
+
+  if (n_values)
+    *n_values = property.n_values;
+
+  /* Distinguish empty properties from errors */
+  return property.values ?: g_new0 (guint32, 1);
+}
+
+/**
+ * gm_device_tree_read_boolean:
+ * @sysfs_root:(nullable): Path where /sys is mounted. Defaults to `/sys` if %NULL is passed.
+ * @node: The path of the device tree node
+ * @name: The property's name
+ *
+ * Reads a boolean property. Boolean properties are true if present.
+ *
+ * Returns: %TRUE if the property is present, otherwise %FALSE
+ *
+ * Since: 0.8.0
+ */
+gboolean
+gm_device_tree_read_boolean (const char *sysfs_root, const char *node, const char *name)
+{
+  GmDeviceTreeProperty property = { .name = name, .type = GM_DEVICE_TREE_PROPERTY_BOOLEAN };
+
+  g_return_val_if_fail (name != NULL, FALSE);
+
+  return gm_device_tree_read_properties (sysfs_root, node, &property, 1, NULL) && property.found;
 }
@@ -12,10 +12,85 @@
 #error "Only <gmobile.h> can be included directly."
 #endif
 
-#include <glib.h>
+#include <glib-object.h>
 
 G_BEGIN_DECLS
 
-GStrv       gm_device_tree_get_compatibles (const char *sysfs_root, GError **err);
+typedef struct _GmDeviceTreeCompatibles GmDeviceTreeCompatibles;
+
+/**
+ * GmDeviceTreePropertyType:
+ * @GM_DEVICE_TREE_PROPERTY_STRINGS: A list of NUL separated strings
+ * @GM_DEVICE_TREE_PROPERTY_U32_ARRAY: An array of big endian 32 bit cells
+ * @GM_DEVICE_TREE_PROPERTY_BOOLEAN: A property that is either present or not
+ *
+ * How to interpret a device tree property's value.
+ *
+ * Since: 0.8.0
+ */
+typedef enum {
+  GM_DEVICE_TREE_PROPERTY_STRINGS = 0,
+  GM_DEVICE_TREE_PROPERTY_U32_ARRAY = 1,
+  GM_DEVICE_TREE_PROPERTY_BOOLEAN = 2,
+} GmDeviceTreePropertyType;
+
+/**
+ * GmDeviceTreeProperty:
+ * @name: The property's name
+ * @type: How to interpret the property's value
+ * @found: Whether the property exists
+ * @strings: The strings for %GM_DEVICE_TREE_PROPERTY_STRINGS
+ * @values: (array length=n_values): The values for %GM_DEVICE_TREE_PROPERTY_U32_ARRAY
+ * @n_values: The number of `values`
+ *
+ * A property to read via [func@device_tree_read_properties]. `name` and
+ * `type` are filled in by the caller, the rest is filled in when reading.
+ * Use [func@device_tree_property_clear] to free the read data.
+ *
+ * Since: 0.8.0
+ */
+typedef struct _GmDeviceTreeProperty {
+  const char               *name;
+  GmDeviceTreePropertyType  type;
+  /*< out >*/
+  gboolean                  found;
+  GStrv                     strings;
+  guint32                  *values;
+  gsize                     n_values;
+} GmDeviceTreeProperty;
+
+#define GM_TYPE_DEVICE_TREE_COMPATIBLES (gm_device_tree_compatibles_get_type ())
+
+GStrv                    gm_device_tree_get_compatibles (const char *sysfs_root, GError **err);
+GmDeviceTreeCompatibles *gm_device_tree_get_cached_compatibles (const char  *sysfs_root,
+                                                                GError     **err);
+void                     gm_device_tree_invalidate_compatibles (const char *sysfs_root);
+
+gboolean                 gm_device_tree_read_properties (const char            *sysfs_root,
+                                                         const char            *node,
+                                                         GmDeviceTreeProperty  *properties,
+                                                         guint                  n_properties,
+                                                         GError               **err);
+void                     gm_device_tree_property_clear  (GmDeviceTreeProperty  *property);
+GStrv                    gm_device_tree_read_strings    (const char            *sysfs_root,
+                                                         const char            *node,
+                                                         const char            *name,
+                                                         GError               **err);
+guint32                 *gm_device_tree_read_u32_array  (const char            *sysfs_root,
+                                                         const char            *node,
+                                                         const char            *name,
+                                                         gsize                 *n_values,
+                                                         GError               **err);
+gboolean                 gm_device_tree_read_boolean    (const char            *sysfs_root,
+                                                         const char            *node,
+                                                         const char            *name);
+
+GType                    gm_device_tree_compatibles_get_type (void) G_GNUC_CONST;
+GmDeviceTreeCompatibles *gm_device_tree_compatibles_ref (GmDeviceTreeCompatibles *self);
+void                     gm_device_tree_compatibles_unref (GmDeviceTreeCompatibles *self);
+const char * const      *gm_device_tree_compatibles_get_strv (GmDeviceTreeCompatibles *self,
+                                                              guint                   *n_compatibles);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (GmDeviceTreeCompatibles, gm_device_tree_compatibles_unref)
 
 G_END_DECLS
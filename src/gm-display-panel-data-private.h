@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#include "gm-rect.h"
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef struct _GmDisplayPanelCutoutData {
+  char   *name;
+  char   *path;
+  GmRect  bounds;
+} GmDisplayPanelCutoutData;
+
+/*
+ * The parsed contents of a display panel description. This is what
+ * `GmDisplayPanel` and `GmCutout` get built from.
+ */
+typedef struct _GmDisplayPanelData {
+  char                     *name;
+  int                       x_res;
+  int                       y_res;
+  int                       width;
+  int                       height;
+  int                       corner_radii[4];
+  GmDisplayPanelCutoutData *cutouts;
+  guint                     n_cutouts;
+} GmDisplayPanelData;
+
+gboolean gm_display_panel_data_parse (GmDisplayPanelData *data,
+                                      const char         *json,
+                                      gssize              length,
+                                      GError            **err);
+void     gm_display_panel_data_clear (GmDisplayPanelData *data);
+
+G_DEFINE_AUTO_CLEANUP_CLEAR_FUNC (GmDisplayPanelData, gm_display_panel_data_clear)
+
+G_END_DECLS
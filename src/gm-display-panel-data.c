@@ -0,0 +1,723 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "gm-display-panel-data-private.h"
+#include "gm-error.h"
+#include "gm-svg-path.h"
+#include "gm-trace-private.h"
+
+#include <stdarg.h>
+#include <string.h>
+
+/*
+ * A parser for the display panel description format. The schema is
+ * small and fixed so we parse it in a single pass directly into a
+ * `GmDisplayPanelData` instead of going through a generic JSON tree,
+ * GValues and GObject properties. All data is validated while
+ * reading and errors carry the line and column of the offending
+ * input.
+ */
+
+#define MAX_DEPTH 64
+
+typedef struct {
+  const char *start;
+  const char *pos;
+  const char *end;
+  /* Scratch buffer for the most recently read string */
+  GString    *buf;
+} PanelReader;
+
+
+static void reader_set_error (PanelReader *reader,
+                              const char *at,
+                              GError    **err,
+                              const char *format,
+                              ...) G_GNUC_PRINTF (4, 5);
+
+static void
+reader_set_error (PanelReader *reader, const char *at, GError **err, const char *format, ...)
+{
+  g_autofree char *msg = NULL;
+  guint line = 1, col = 1;
+  va_list args;
+
+  if (err == NULL)
+    return;
+
+  for (const char *p = reader->start; p < at; p++) {
+    if (*p == '\n') {
+      line++;
+      col = 1;
+    } else {
+      col++;
+    }
+  }
+
+  va_start (args, format);
+  msg = g_strdup_vprintf (format, args);
+  va_end (args);
+
+  g_set_error (err, GM_ERROR, GM_ERROR_PARSING_FAILED, "%u:%u: %s", line, col, msg);
+}
+
+
+static void
+skip_whitespace (PanelReader *reader)
+{
+  while (reader->pos < reader->end &&
+         (*reader->pos == ' ' || *reader->pos == '\t' ||
+          *reader->pos == '\n' || *reader->pos == '\r')) {
+    reader->pos++;
+  }
+}
+
+
+static gboolean
+peek (PanelReader *reader, char c)
+{
+  skip_whitespace (reader);
+
+  return reader->pos < reader->end && *reader->pos == c;
+}
+
+
+static gboolean
+expect (PanelReader *reader, char c, GError **err)
+{
+  skip_whitespace (reader);
+
+  if (reader->pos >= reader->end) {
+    reader_set_error (reader, reader->pos, err, "Unexpected end of data, expected '%c'", c);
+    return FALSE;
+  }
+
+  if (*reader->pos != c) {
+    reader_set_error (reader, reader->pos, err, "Expected '%c'", c);
+    return FALSE;
+  }
+
+  reader->pos++;
+  return TRUE;
+}
+
+
+static gboolean
+read_literal (PanelReader *reader, const char *literal)
+{
+  gsize len = strlen (literal);
+
+  skip_whitespace (reader);
+
+  if ((gsize)(reader->end - reader->pos) < len || memcmp (reader->pos, literal, len) != 0)
+    return FALSE;
+
+  reader->pos += len;
+  return TRUE;
+}
+
+/* Reads the next element separator of an object or array */
+static gboolean
+read_next (PanelReader *reader, char close, gboolean *done, GError **err)
+{
+  skip_whitespace (reader);
+
+  if (reader->pos < reader->end && *reader->pos == ',') {
+    reader->pos++;
+    *done = FALSE;
+    return TRUE;
+  }
+
+  if (reader->pos < reader->end && *reader->pos == close) {
+    reader->pos++;
+    *done = TRUE;
+    return TRUE;
+  }
+
+  reader_set_error (reader, reader->pos, err, "Expected ',' or '%c'", close);
+  return FALSE;
+}
+
+
+static gboolean
+parse_hex4 (const char *p, const char *end, gunichar *value)
+{
+  gunichar c = 0;
+
+  if (end - p < 4)
+    return FALSE;
+
+  for (int i = 0; i < 4; i++) {
+    int digit = g_ascii_xdigit_value (p[i]);
+
+    if (digit < 0)
+      return FALSE;
+    c = (c << 4) | digit;
+  }
+
+  *value = c;
+  return TRUE;
+}
+
+/* Reads a string into the reader's scratch buffer */
+static gboolean
+read_string (PanelReader *reader, GError **err)
+{
+  const char *begin;
+  const char *p;
+
+  skip_whitespace (reader);
+  begin = reader->pos;
+  if (!expect (reader, '"', err))
+    return FALSE;
+
+  g_string_truncate (reader->buf, 0);
+  p = reader->pos;
+  while (TRUE) {
+    const char *run = p;
+    gunichar c;
+
+    while (p < reader->end && *p != '"' && *p != '\\' && (guchar)*p >= 0x20)
+      p++;
+    g_string_append_len (reader->buf, run, p - run);
+
+    if (p >= reader->end) {
+      reader_set_error (reader, begin, err, "Unterminated string");
+      return FALSE;
+    }
+
+    if (*p == '"') {
+      p++;
+      break;
+    }
+
+    if (*p != '\\') {
+      reader_set_error (reader, p, err, "Control character in string");
+      return FALSE;
+    }
+
+    p++;
+    if (p >= reader->end) {
+      reader_set_error (reader, begin, err, "Unterminated string");
+      return FALSE;
+    }
+
+    switch (*p) {
+    case '"':
+    case '\\':
+    case '/':
+      g_string_append_c (reader->buf, *p);
+      p++;
+      break;
+    case 'b':
+      g_string_append_c (reader->buf, '\b');
+      p++;
+      break;
+    case 'f':
+      g_string_append_c (reader->buf, '\f');
+      p++;
+      break;
+    case 'n':
+      g_string_append_c (reader->buf, '\n');
+      p++;
+      break;
+    case 'r':
+      g_string_append_c (reader->buf, '\r');
+      p++;
+      break;
+    case 't':
+      g_string_append_c (reader->buf, '\t');
+      p++;
+      break;
+    case 'u':
+      if (!parse_hex4 (p + 1, reader->end, &c)) {
+        reader_set_error (reader, p - 1, err, "Invalid unicode escape");
+        return FALSE;
+      }
+      p += 5;
+
+      if (c >= 0xd800 && c < 0xdc00) {
+        gunichar low;
+
+        if (reader->end - p < 6 || p[0] != '\\' || p[1] != 'u' ||
+            !parse_hex4 (p + 2, reader->end, &low) || low < 0xdc00 || low >= 0xe000) {
+          reader_set_error (reader, p - 6, err, "Invalid surrogate pair");
+          return FALSE;
+        }
+        c = 0x10000 + ((c - 0xd800) << 10) + (low - 0xdc00);
+        p += 6;
+      } else if (c >= 0xdc00 && c < 0xe000) {
+        reader_set_error (reader, p - 6, err, "Invalid surrogate pair");
+        return FALSE;
+      } else if (c == 0) {
+        reader_set_error (reader, p - 6, err, "NUL character in string");
+        return FALSE;
+      }
+      g_string_append_unichar (reader->buf, c);
+      break;
+    default:
+      reader_set_error (reader, p - 1, err, "Invalid escape sequence");
+      return FALSE;
+    }
+  }
+
+  if (!g_utf8_validate (reader->buf->str, reader->buf->len, NULL)) {
+    reader_set_error (reader, begin, err, "Invalid UTF-8 in string");
+    return FALSE;
+  }
+
+  reader->pos = p;
+  return TRUE;
+}
+
+
+static gboolean
+read_nullable_string (PanelReader *reader, char **value, GError **err)
+{
+  g_clear_pointer (value, g_free);
+
+  if (read_literal (reader, "null"))
+    return TRUE;
+
+  if (!read_string (reader, err))
+    return FALSE;
+
+  *value = g_strdup (reader->buf->str);
+  return TRUE;
+}
+
+
+static gboolean
+read_dimension (PanelReader *reader, const char *key, int *value, GError **err)
+{
+  const char *begin;
+  gint64 val = 0;
+
+  skip_whitespace (reader);
+  begin = reader->pos;
+
+  if (reader->pos < reader->end && *reader->pos == '-') {
+    reader_set_error (reader, begin, err, "'%s' must not be negative", key);
+    return FALSE;
+  }
+
+  if (reader->pos >= reader->end || !g_ascii_isdigit (*reader->pos)) {
+    reader_set_error (reader, begin, err, "'%s' must be an integer", key);
+    return FALSE;
+  }
+
+  if (*reader->pos == '0' && reader->pos + 1 < reader->end && g_ascii_isdigit (reader->pos[1])) {
+    reader_set_error (reader, begin, err, "Leading zeros in '%s'", key);
+    return FALSE;
+  }
+
+  while (reader->pos < reader->end && g_ascii_isdigit (*reader->pos)) {
+    val = val * 10 + (*reader->pos - '0');
+    if (val > G_MAXINT) {
+      reader_set_error (reader, begin, err, "'%s' is too large", key);
+      return FALSE;
+    }
+    reader->pos++;
+  }
+
+  if (reader->pos < reader->end &&
+      (*reader->pos == '.' || *reader->pos == 'e' || *reader->pos == 'E')) {
+    reader_set_error (reader, begin, err, "'%s' must be an integer", key);
+    return FALSE;
+  }
+
+  *value = val;
+  return TRUE;
+}
+
+
+static gboolean
+skip_digits (PanelReader *reader)
+{
+  const char *begin = reader->pos;
+
+  while (reader->pos < reader->end && g_ascii_isdigit (*reader->pos))
+    reader->pos++;
+
+  return reader->pos != begin;
+}
+
+
+static gboolean
+skip_number (PanelReader *reader, GError **err)
+{
+  const char *begin = reader->pos;
+
+  if (*reader->pos == '-')
+    reader->pos++;
+
+  if (!skip_digits (reader))
+    goto invalid;
+
+  if (reader->pos < reader->end && *reader->pos == '.') {
+    reader->pos++;
+    if (!skip_digits (reader))
+      goto invalid;
+  }
+
+  if (reader->pos < reader->end && (*reader->pos == 'e' || *reader->pos == 'E')) {
+    reader->pos++;
+    if (reader->pos < reader->end && (*reader->pos == '+' || *reader->pos == '-'))
+      reader->pos++;
+    if (!skip_digits (reader))
+      goto invalid;
+  }
+
+  return TRUE;
+
+ invalid:
+  reader_set_error (reader, begin, err, "Invalid number");
+  return FALSE;
+}
+
+/* Skips over a value of a member we don't know about */
+static gboolean
+skip_value (PanelReader *reader, guint depth, GError **err)
+{
+  gboolean done = FALSE;
+  char close;
+
+  skip_whitespace (reader);
+
+  if (reader->pos >= reader->end) {
+    reader_set_error (reader, reader->pos, err, "Unexpected end of data");
+    return FALSE;
+  }
+
+  if (depth > MAX_DEPTH) {
+    reader_set_error (reader, reader->pos, err, "Data nested too deeply");
+    return FALSE;
+  }
+
+  switch (*reader->pos) {
+  case '"':
+    return read_string (reader, err);
+  case '{':
+  case '[':
+    close = *reader->pos == '{' ? '}' : ']';
+    reader->pos++;
+    if (peek (reader, close)) {
+      reader->pos++;
+      return TRUE;
+    }
+
+    while (!done) {
+      if (close == '}') {
+        if (!read_string (reader, err))
+          return FALSE;
+        if (!expect (reader, ':', err))
+          return FALSE;
+      }
+      if (!skip_value (reader, depth + 1, err))
+        return FALSE;
+      if (!read_next (reader, close, &done, err))
+        return FALSE;
+    }
+    return TRUE;
+  case 't':
+  case 'f':
+  case 'n':
+    if (read_literal (reader, "true") || read_literal (reader, "false") ||
+        read_literal (reader, "null")) {
+      return TRUE;
+    }
+    break;
+  default:
+    if (*reader->pos == '-' || g_ascii_isdigit (*reader->pos))
+      return skip_number (reader, err);
+    break;
+  }
+
+  reader_set_error (reader, reader->pos, err, "Unexpected character");
+  return FALSE;
+}
+
+
+static gboolean
+read_corner_radii (PanelReader *reader, int radii[4], GError **err)
+{
+  const char *begin;
+  gboolean done = FALSE;
+  int values[4];
+  guint n = 0;
+
+  skip_whitespace (reader);
+  begin = reader->pos;
+  if (!expect (reader, '[', err))
+    return FALSE;
+
+  if (peek (reader, ']')) {
+    reader->pos++;
+    done = TRUE;
+  }
+
+  while (!done && n < G_N_ELEMENTS (values)) {
+    if (!read_dimension (reader, "corner-radii", &values[n], err))
+      return FALSE;
+    n++;
+    if (!read_next (reader, ']', &done, err))
+      return FALSE;
+  }
+
+  if (!done || n != G_N_ELEMENTS (values)) {
+    reader_set_error (reader, begin, err, "'corner-radii' needs exactly 4 elements");
+    return FALSE;
+  }
+
+  memcpy (radii, values, sizeof (values));
+  return TRUE;
+}
+
+
+static void
+gm_display_panel_cutout_data_clear (GmDisplayPanelCutoutData *cutout)
+{
+  g_clear_pointer (&cutout->name, g_free);
+  g_clear_pointer (&cutout->path, g_free);
+}
+
+
+static gboolean
+read_cutout (PanelReader *reader, GmDisplayPanelCutoutData *cutout, GError **err)
+{
+  g_autoptr (GError) local_err = NULL;
+  const char *begin, *path_pos = NULL;
+  gboolean done = FALSE;
+  int x1, x2, y1, y2;
+
+  skip_whitespace (reader);
+  begin = reader->pos;
+  if (!expect (reader, '{', err))
+    return FALSE;
+
+  if (peek (reader, '}')) {
+    reader->pos++;
+    done = TRUE;
+  }
+
+  while (!done) {
+    if (!read_string (reader, err))
+      return FALSE;
+    if (!expect (reader, ':', err))
+      return FALSE;
+
+    if (g_str_equal (reader->buf->str, "name")) {
+      if (!read_nullable_string (reader, &cutout->name, err))
+        return FALSE;
+    } else if (g_str_equal (reader->buf->str, "path")) {
+      skip_whitespace (reader);
+      path_pos = reader->pos;
+      if (!read_string (reader, err))
+        return FALSE;
+      g_free (cutout->path);
+      cutout->path = g_strdup (reader->buf->str);
+    } else if (!skip_value (reader, 2, err)) {
+      return FALSE;
+    }
+
+    if (!read_next (reader, '}', &done, err))
+      return FALSE;
+  }
+
+  if (cutout->path == NULL) {
+    reader_set_error (reader, begin, err, "Cutout lacks a 'path'");
+    return FALSE;
+  }
+
+  if (!gm_svg_path_get_bounding_box (cutout->path, &x1, &x2, &y1, &y2, &local_err)) {
+    reader_set_error (reader, path_pos, err, "Invalid cutout path: %s", local_err->message);
+    return FALSE;
+  }
+
+  cutout->bounds.x = x1;
+  cutout->bounds.y = y1;
+  cutout->bounds.width = x2 - x1;
+  cutout->bounds.height = y2 - y1;
+
+  return TRUE;
+}
+
+
+static gboolean
+read_cutouts (PanelReader *reader, GArray **cutouts, GError **err)
+{
+  g_autoptr (GArray) array = NULL;
+  gboolean done = FALSE;
+
+  g_clear_pointer (cutouts, g_array_unref);
+
+  if (read_literal (reader, "null"))
+    return TRUE;
+
+  if (!expect (reader, '[', err))
+    return FALSE;
+
+  array = g_array_new (FALSE, TRUE, sizeof (GmDisplayPanelCutoutData));
+  g_array_set_clear_func (array, (GDestroyNotify) gm_display_panel_cutout_data_clear);
+
+  if (peek (reader, ']')) {
+    reader->pos++;
+    done = TRUE;
+  }
+
+  while (!done) {
+    GmDisplayPanelCutoutData cutout = { NULL };
+
+    if (!read_cutout (reader, &cutout, err)) {
+      gm_display_panel_cutout_data_clear (&cutout);
+      return FALSE;
+    }
+    g_array_append_val (array, cutout);
+
+    if (!read_next (reader, ']', &done, err))
+      return FALSE;
+  }
+
+  *cutouts = g_steal_pointer (&array);
+  return TRUE;
+}
+
+
+static gboolean
+read_panel (PanelReader *reader, GmDisplayPanelData *data, GError **err)
+{
+  g_autoptr (GArray) cutouts = NULL;
+  gboolean done = FALSE;
+
+  if (!expect (reader, '{', err))
+    return FALSE;
+
+  if (peek (reader, '}')) {
+    reader->pos++;
+    done = TRUE;
+  }
+
+  while (!done) {
+    const char *key;
+
+    if (!read_string (reader, err))
+      return FALSE;
+    if (!expect (reader, ':', err))
+      return FALSE;
+
+    key = reader->buf->str;
+    if (g_str_equal (key, "name")) {
+      if (!read_nullable_string (reader, &data->name, err))
+        return FALSE;
+    } else if (g_str_equal (key, "x-res")) {
+      if (!read_dimension (reader, "x-res", &data->x_res, err))
+        return FALSE;
+    } else if (g_str_equal (key, "y-res")) {
+      if (!read_dimension (reader, "y-res", &data->y_res, err))
+        return FALSE;
+    } else if (g_str_equal (key, "width")) {
+      if (!read_dimension (reader, "width", &data->width, err))
+        return FALSE;
+    } else if (g_str_equal (key, "height")) {
+      if (!read_dimension (reader, "height", &data->height, err))
+        return FALSE;
+    } else if (g_str_equal (key, "border-radius")) {
+      int radius;
+
+      if (!read_dimension (reader, "border-radius", &radius, err))
+        return FALSE;
+      for (int i = 0; i < G_N_ELEMENTS (data->corner_radii); i++)
+        data->corner_radii[i] = radius;
+    } else if (g_str_equal (key, "corner-radii")) {
+      if (!read_corner_radii (reader, data->corner_radii, err))
+        return FALSE;
+    } else if (g_str_equal (key, "cutouts")) {
+      if (!read_cutouts (reader, &cutouts, err))
+        return FALSE;
+    } else if (!skip_value (reader, 1, err)) {
+      return FALSE;
+    }
+
+    if (!read_next (reader, '}', &done, err))
+      return FALSE;
+  }
+
+  if (cutouts) {
+    data->n_cutouts = cutouts->len;
+    data->cutouts = g_array_steal (cutouts, NULL);
+  }
+
+  return TRUE;
+}
+
+/**
+ * gm_display_panel_data_parse:
+ * @data: The panel data to fill
+ * @json: The panel description as JSON
+ * @length: The length of `json` or -1 if it's NUL terminated
+ * @err: Return location for an error
+ *
+ * Parses a display panel description. On error `FALSE` is returned,
+ * `err` is set and `data` is left empty. On success the caller must
+ * free the contents of `data` with [func@display_panel_data_clear].
+ *
+ * Returns: `TRUE` on success, otherwise `FALSE`
+ */
+gboolean
+gm_display_panel_data_parse (GmDisplayPanelData *data,
+                             const char         *json,
+                             gssize              length,
+                             GError            **err)
+{
+  g_autoptr (GString) buf = g_string_new (NULL);
+  gint64 begin = GM_TRACE_CURRENT_TIME;
+  PanelReader reader;
+
+  g_return_val_if_fail (data, FALSE);
+  g_return_val_if_fail (json, FALSE);
+  g_return_val_if_fail (err == NULL || *err == NULL, FALSE);
+
+  memset (data, 0, sizeof (*data));
+
+  reader.start = json;
+  reader.pos = json;
+  reader.end = json + (length < 0 ? strlen (json) : length);
+  reader.buf = buf;
+
+  if (!read_panel (&reader, data, err)) {
+    gm_display_panel_data_clear (data);
+    return FALSE;
+  }
+
+  skip_whitespace (&reader);
+  if (reader.pos != reader.end) {
+    reader_set_error (&reader, reader.pos, err, "Trailing data after panel description");
+    gm_display_panel_data_clear (data);
+    return FALSE;
+  }
+
+  GM_TRACE_MARK (begin, "parse-panel", "%s: %u cutouts", data->name ?: "(unnamed)", data->n_cutouts);
+  GM_TRACE_COUNTER_ADD (GM_TRACE_COUNTER_PARSED_PANELS, 1);
+
+  return TRUE;
+}
+
+/**
+ * gm_display_panel_data_clear:
+ * @data: The panel data
+ *
+ * Frees the contents of `data`.
+ */
+void
+gm_display_panel_data_clear (GmDisplayPanelData *data)
+{
+  for (guint i = 0; i < data->n_cutouts; i++)
+    gm_display_panel_cutout_data_clear (&data->cutouts[i]);
+
+  g_clear_pointer (&data->cutouts, g_free);
+  g_clear_pointer (&data->name, g_free);
+  memset (data, 0, sizeof (*data));
+}
@@ -0,0 +1,18 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#include "gm-display-panel-snapshot.h"
+
+#include <gio/gio.h>
+
+G_BEGIN_DECLS
+
+GmDisplayPanelSnapshot *gm_display_panel_snapshot_new (const GmDisplayPanelSnapshot *geometry,
+                                                       GListModel                   *cutouts);
+
+G_END_DECLS
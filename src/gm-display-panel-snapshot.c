@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "gm-cutout.h"
+#include "gm-display-panel-snapshot-private.h"
+
+/**
+ * GmDisplayPanelSnapshotCutout:
+ * @bounds: The bounding box of the cutout
+ * @name: (nullable): The name of the cutout
+ * @path: The SVG path describing the cutout
+ *
+ * A display cutout within a [struct@DisplayPanelSnapshot].
+ *
+ * Since: 0.8.0
+ */
+
+/**
+ * GmDisplayPanelSnapshot:
+ * @x_res: The panel resolution in pixels in the x direction
+ * @y_res: The panel resolution in pixels in the y direction
+ * @width: The panel width in millimeters
+ * @height: The panel height in millimeters
+ * @corner_radii: The corner radii starting top-left and going clockwise,
+ *   see [enum@CornerPosition]
+ * @n_cutouts: The number of cutouts
+ * @cutouts: (array length=n_cutouts): The cutouts
+ *
+ * An immutable snapshot of a [class@DisplayPanel]'s geometry.
+ *
+ * The snapshot is a single reference counted block of memory holding
+ * the panel's geometry and all its cutouts. As it never changes it
+ * can be handed to other threads (e.g. a render or input thread) and
+ * read there without locking or further allocations.
+ *
+ * Since: 0.8.0
+ */
+
+G_DEFINE_BOXED_TYPE (GmDisplayPanelSnapshot,
+                     gm_display_panel_snapshot,
+                     gm_display_panel_snapshot_ref,
+                     gm_display_panel_snapshot_unref)
+
+/**
+ * gm_display_panel_snapshot_new:
+ * @geometry: The panel's geometry, cutouts are ignored
+ * @cutouts:(nullable): The panel's cutouts as list of [class@Cutout]
+ *
+ * Builds a snapshot. Cutout names and paths are copied into the
+ * same allocation as the rest of the data.
+ *
+ * Returns:(transfer full): The snapshot
+ */
+GmDisplayPanelSnapshot *
+gm_display_panel_snapshot_new (const GmDisplayPanelSnapshot *geometry, GListModel *cutouts)
+{
+  GmDisplayPanelSnapshot *self;
+  GmDisplayPanelSnapshotCutout *entries;
+  guint n_cutouts = cutouts ? g_list_model_get_n_items (cutouts) : 0;
+  gsize size = sizeof (GmDisplayPanelSnapshot) + n_cutouts * sizeof (GmDisplayPanelSnapshotCutout);
+  char *strings;
+
+  for (guint i = 0; i < n_cutouts; i++) {
+    g_autoptr (GmCutout) cutout = g_list_model_get_item (cutouts, i);
+    const char *name = gm_cutout_get_name (cutout);
+    const char *path = gm_cutout_get_path (cutout);
+
+    size += name ? strlen (name) + 1 : 0;
+    size += path ? strlen (path) + 1 : 0;
+  }
+
+  self = g_atomic_rc_box_alloc0 (size);
+  *self = *geometry;
+  self->n_cutouts = n_cutouts;
+
+  entries = (GmDisplayPanelSnapshotCutout *)(self + 1);
+  strings = (char *)(entries + n_cutouts);
+  for (guint i = 0; i < n_cutouts; i++) {
+    g_autoptr (GmCutout) cutout = g_list_model_get_item (cutouts, i);
+    const char *name = gm_cutout_get_name (cutout);
+    const char *path = gm_cutout_get_path (cutout);
+
+    entries[i].bounds = *gm_cutout_get_bounds (cutout);
+    if (name) {
+      entries[i].name = strings;
+      strings = g_stpcpy (strings, name) + 1;
+    }
+    if (path) {
+      entries[i].path = strings;
+      strings = g_stpcpy (strings, path) + 1;
+    }
+  }
+  self->cutouts = n_cutouts ? entries : NULL;
+
+  return self;
+}
+
+/**
+ * gm_display_panel_snapshot_ref:
+ * @self: The snapshot
+ *
+ * Acquires a reference on the snapshot. This is thread safe.
+ *
+ * Returns:(transfer full): The snapshot
+ *
+ * Since: 0.8.0
+ */
+GmDisplayPanelSnapshot *
+gm_display_panel_snapshot_ref (GmDisplayPanelSnapshot *self)
+{
+  g_return_val_if_fail (self, NULL);
+
+  return g_atomic_rc_box_acquire (self);
+}
+
+/**
+ * gm_display_panel_snapshot_unref:
+ * @self: The snapshot
+ *
+ * Releases a reference on the snapshot. This is thread safe.
+ *
+ * Since: 0.8.0
+ */
+void
+gm_display_panel_snapshot_unref (GmDisplayPanelSnapshot *self)
+{
+  g_return_if_fail (self);
+
+  g_atomic_rc_box_release (self);
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_GMOBILE_INSIDE) && !defined(GMOBILE_COMPILATION)
+#error "Only <gmobile.h> can be included directly."
+#endif
+
+#include "gm-rect.h"
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+typedef struct _GmDisplayPanelSnapshotCutout {
+  GmRect      bounds;
+  const char *name;
+  const char *path;
+} GmDisplayPanelSnapshotCutout;
+
+typedef struct _GmDisplayPanelSnapshot {
+  int                                 x_res;
+  int                                 y_res;
+  int                                 width;
+  int                                 height;
+  int                                 corner_radii[4];
+  guint                               n_cutouts;
+  const GmDisplayPanelSnapshotCutout *cutouts;
+} GmDisplayPanelSnapshot;
+
+#define GM_TYPE_DISPLAY_PANEL_SNAPSHOT (gm_display_panel_snapshot_get_type ())
+
+GType                   gm_display_panel_snapshot_get_type (void) G_GNUC_CONST;
+GmDisplayPanelSnapshot *gm_display_panel_snapshot_ref (GmDisplayPanelSnapshot *self);
+void                    gm_display_panel_snapshot_unref (GmDisplayPanelSnapshot *self);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (GmDisplayPanelSnapshot, gm_display_panel_snapshot_unref)
+
+G_END_DECLS
@@ -6,11 +6,17 @@
  * Author: Guido Günther <agx@sigxcpu.org>
  */
 
-#include "gm-cutout.h"
+#include "gm-cutout-private.h"
 #include "gm-display-panel.h"
-#include "gm-main.h"
+#include "gm-display-panel-data-private.h"
+#include "gm-display-panel-snapshot-private.h"
+#include "gm-device-db-private.h"
+#include "gm-stats-private.h"
+#include "gm-trace-private.h"
 
-#include <json-glib/json-glib.h>
+#ifdef GM_HAVE_JSON_GLIB
+# include <json-glib/json-glib.h>
+#endif
 
 /**
  * GmDisplayPanel:
@@ -45,13 +51,43 @@ struct _GmDisplayPanel {
   int         corner_radii[4];
   int         width;
   int         height;
+
+  GmDisplayPanelSnapshot *snapshot;
 };
 
+#ifdef GM_HAVE_JSON_GLIB
 static void gm_display_panel_json_serializable_iface_init (JsonSerializableIface *iface);
 
 G_DEFINE_TYPE_WITH_CODE (GmDisplayPanel, gm_display_panel, G_TYPE_OBJECT,
                          G_IMPLEMENT_INTERFACE (JSON_TYPE_SERIALIZABLE,
                                                 gm_display_panel_json_serializable_iface_init));
+#else
+G_DEFINE_TYPE (GmDisplayPanel, gm_display_panel, G_TYPE_OBJECT)
+#endif
+
+
+static void
+gm_display_panel_invalidate_snapshot (GmDisplayPanel *self)
+{
+  g_clear_pointer (&self->snapshot, gm_display_panel_snapshot_unref);
+}
+
+
+static void
+gm_display_panel_set_cutouts (GmDisplayPanel *self, GListStore *cutouts)
+{
+  if (self->cutouts)
+    g_signal_handlers_disconnect_by_data (self->cutouts, self);
+
+  g_set_object (&self->cutouts, cutouts);
+
+  /* Cutouts can be modified via the list model */
+  if (self->cutouts) {
+    g_signal_connect_swapped (self->cutouts, "items-changed",
+                              G_CALLBACK (gm_display_panel_invalidate_snapshot),
+                              self);
+  }
+}
 
 
 static void
@@ -85,13 +121,15 @@ gm_display_panel_set_property (GObject      *object,
 {
   GmDisplayPanel *self = GM_DISPLAY_PANEL (object);
 
+  gm_display_panel_invalidate_snapshot (self);
+
   switch (property_id) {
   case PROP_NAME:
     g_free (self->name);
     self->name = g_value_dup_string (value);
     break;
   case PROP_CUTOUTS:
-    g_set_object (&self->cutouts, g_value_get_object (value));
+    gm_display_panel_set_cutouts (self, g_value_get_object (value));
     break;
   case PROP_X_RES:
     self->x_res = g_value_get_int (value);
@@ -160,6 +198,7 @@ G_GNUC_END_IGNORE_DEPRECATIONS
 }
 
 
+#ifdef GM_HAVE_JSON_GLIB
 static JsonNode *
 gm_display_panel_serializable_serialize_property (JsonSerializable *serializable,
                                                   const gchar      *property_name,
@@ -267,6 +306,7 @@ gm_display_panel_json_serializable_iface_init (JsonSerializableIface *iface)
   iface->serialize_property = gm_display_panel_serializable_serialize_property;
   iface->deserialize_property = gm_display_panel_serializable_deserialize_property;
 }
+#endif
 
 
 static void
@@ -274,9 +314,12 @@ gm_display_panel_finalize (GObject *object)
 {
   GmDisplayPanel *self = GM_DISPLAY_PANEL (object);
 
-  g_clear_object (&self->cutouts);
+  gm_display_panel_invalidate_snapshot (self);
+  gm_display_panel_set_cutouts (self, NULL);
   g_clear_pointer (&self->name, g_free);
 
+  gm_stats_object_removed (GM_STATS_OBJECT_DISPLAY_PANEL, sizeof (GmDisplayPanel));
+
   G_OBJECT_CLASS (gm_display_panel_parent_class)->finalize (object);
 }
 
@@ -390,7 +433,11 @@ gm_display_panel_class_init (GmDisplayPanelClass *klass)
 static void
 gm_display_panel_init (GmDisplayPanel *self)
 {
-  self->cutouts = g_list_store_new (GM_TYPE_CUTOUT);
+  g_autoptr (GListStore) cutouts = g_list_store_new (GM_TYPE_CUTOUT);
+
+  gm_display_panel_set_cutouts (self, cutouts);
+
+  gm_stats_object_added (GM_STATS_OBJECT_DISPLAY_PANEL, sizeof (GmDisplayPanel));
 }
 
 /**
@@ -416,6 +463,10 @@ gm_display_panel_new (void)
  * Constructs a new display panel based on the given data. If that fails
  * `NULL` is returned and `error` describes the error that occurred.
  *
+ * Changed in 0.8.0: The data is validated while parsing. Invalid
+ * values and cutouts with invalid paths are errors instead of being
+ * ignored. Error messages include the line and column of the problem.
+ *
  * Returns: The new display panel object
  *
  * Since: 0.0.1
@@ -423,11 +474,29 @@ gm_display_panel_new (void)
 GmDisplayPanel *
 gm_display_panel_new_from_data (const gchar *data, GError **error)
 {
-  g_autoptr (JsonNode) node = json_from_string (data, error);
-  if (!node)
+  g_auto (GmDisplayPanelData) panel_data = { NULL };
+  g_autoptr (GPtrArray) cutouts = NULL;
+  GmDisplayPanel *self;
+
+  g_return_val_if_fail (data, NULL);
+
+  if (!gm_display_panel_data_parse (&panel_data, data, -1, error))
     return NULL;
 
-  return GM_DISPLAY_PANEL (json_gobject_deserialize (GM_TYPE_DISPLAY_PANEL, node));
+  self = gm_display_panel_new ();
+  self->name = g_steal_pointer (&panel_data.name);
+  self->x_res = panel_data.x_res;
+  self->y_res = panel_data.y_res;
+  self->width = panel_data.width;
+  self->height = panel_data.height;
+  memcpy (self->corner_radii, panel_data.corner_radii, sizeof (self->corner_radii));
+
+  cutouts = g_ptr_array_new_full (panel_data.n_cutouts, g_object_unref);
+  for (guint i = 0; i < panel_data.n_cutouts; i++)
+    g_ptr_array_add (cutouts, gm_cutout_new_from_data (&panel_data.cutouts[i]));
+  g_list_store_splice (self->cutouts, 0, 0, cutouts->pdata, cutouts->len);
+
+  return self;
 }
 
 /**
@@ -447,13 +516,16 @@ GmDisplayPanel *
 gm_display_panel_new_from_resource (const gchar *resource_name, GError **error)
 {
   g_autoptr (GBytes) bytes = NULL;
+  gint64 begin;
 
   g_return_val_if_fail (resource_name && resource_name[0], NULL);
 
-  /* Make sure resources are initialized */
-  gm_init ();
+  /* Make sure the device database is registered */
+  gm_device_db_get_resource ();
 
+  begin = GM_TRACE_CURRENT_TIME;
   bytes = g_resources_lookup_data (resource_name, 0, error);
+  GM_TRACE_MARK (begin, "lookup-resource", "%s", resource_name);
   if (bytes == NULL)
     return NULL;
 
@@ -631,3 +703,92 @@ gm_display_panel_get_height (GmDisplayPanel *self)
 
   return self->height;
 }
+
+/**
+ * gm_display_panel_get_snapshot:
+ * @self: The display panel
+ *
+ * Gets an immutable snapshot of the panel's geometry including its
+ * cutouts. Unlike the panel itself the snapshot can be passed to and
+ * read from other threads without locking. See
+ * [struct@DisplayPanelSnapshot].
+ *
+ * The snapshot is kept until the panel changes so repeated calls are
+ * cheap.
+ *
+ * Returns:(transfer full): The panel's snapshot
+ *
+ * Since: 0.8.0
+ */
+GmDisplayPanelSnapshot *
+gm_display_panel_get_snapshot (GmDisplayPanel *self)
+{
+  g_return_val_if_fail (GM_IS_DISPLAY_PANEL (self), NULL);
+
+  if (self->snapshot == NULL) {
+    GmDisplayPanelSnapshot geometry = {
+      .x_res = self->x_res,
+      .y_res = self->y_res,
+      .width = self->width,
+      .height = self->height,
+    };
+
+    memcpy (geometry.corner_radii, self->corner_radii, sizeof (geometry.corner_radii));
+    self->snapshot = gm_display_panel_snapshot_new (&geometry, G_LIST_MODEL (self->cutouts));
+  }
+
+  return gm_display_panel_snapshot_ref (self->snapshot);
+}
+
+/**
+ * gm_display_panel_get_geometry:
+ * @self: The display panel
+ *
+ * Gets the panel's geometry including its cutouts as a single
+ * [struct@GLib.Variant] of type [const@DISPLAY_PANEL_GEOMETRY_FORMAT].
+ * This is meant for language bindings where fetching every property
+ * individually is expensive. The members are:
+ *
+ * - `s`: the name, empty if unset
+ * - `i`, `i`: the resolution in pixels in x and y direction
+ * - `i`, `i`: the width and height in millimeters
+ * - `(iiii)`: the corner radii starting top-left and going clockwise,
+ *   see [enum@CornerPosition]
+ * - `a(s(iiii)s)`: the cutouts, each with its name (empty if unset),
+ *   its bounding box as x, y, width and height and its SVG path
+ *
+ * Returns:(transfer full): The panel's geometry
+ *
+ * Since: 0.8.0
+ */
+GVariant *
+gm_display_panel_get_geometry (GmDisplayPanel *self)
+{
+  g_autoptr (GmDisplayPanelSnapshot) snapshot = NULL;
+  GVariantBuilder cutouts;
+
+  g_return_val_if_fail (GM_IS_DISPLAY_PANEL (self), NULL);
+
+  snapshot = gm_display_panel_get_snapshot (self);
+
+  g_variant_builder_init (&cutouts, G_VARIANT_TYPE ("a(s(iiii)s)"));
+  for (guint i = 0; i < snapshot->n_cutouts; i++) {
+    const GmDisplayPanelSnapshotCutout *cutout = &snapshot->cutouts[i];
+
+    g_variant_builder_add (&cutouts, "(s(iiii)s)",
+                           cutout->name ?: "",
+                           cutout->bounds.x, cutout->bounds.y,
+                           cutout->bounds.width, cutout->bounds.height,
+                           cutout->path ?: "");
+  }
+
+  return g_variant_ref_sink (g_variant_new (GM_DISPLAY_PANEL_GEOMETRY_FORMAT,
+                                            self->name ?: "",
+                                            snapshot->x_res, snapshot->y_res,
+                                            snapshot->width, snapshot->height,
+                                            snapshot->corner_radii[GM_CORNER_POSITION_TOP_LEFT],
+                                            snapshot->corner_radii[GM_CORNER_POSITION_TOP_RIGHT],
+                                            snapshot->corner_radii[GM_CORNER_POSITION_BOTTOM_RIGHT],
+                                            snapshot->corner_radii[GM_CORNER_POSITION_BOTTOM_LEFT],
+                                            &cutouts));
+}
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "gm-display-panel-snapshot.h"
+
 #include <glib-object.h>
 #include <gio/gio.h>
 
@@ -22,6 +24,16 @@ typedef enum {
 
 #define GM_TYPE_DISPLAY_PANEL (gm_display_panel_get_type ())
 
+/**
+ * GM_DISPLAY_PANEL_GEOMETRY_FORMAT:
+ *
+ * The [struct@GLib.Variant] type string of a panel's geometry as
+ * returned by [method@DisplayPanel.get_geometry].
+ *
+ * Since: 0.8.0
+ */
+#define GM_DISPLAY_PANEL_GEOMETRY_FORMAT "(siiii(iiii)a(s(iiii)s))"
+
 G_DECLARE_FINAL_TYPE (GmDisplayPanel, gm_display_panel, GM, DISPLAY_PANEL, GObject)
 
 GmDisplayPanel     *gm_display_panel_new (void);
@@ -37,5 +49,7 @@ const int *         gm_display_panel_get_corner_radii_array (GmDisplayPanel *sel
 GArray *            gm_display_panel_get_corner_radii (GmDisplayPanel *self);
 int                 gm_display_panel_get_width (GmDisplayPanel *self);
 int                 gm_display_panel_get_height (GmDisplayPanel *self);
+GmDisplayPanelSnapshot *gm_display_panel_get_snapshot (GmDisplayPanel *self);
+GVariant           *gm_display_panel_get_geometry (GmDisplayPanel *self);
 
 G_END_DECLS
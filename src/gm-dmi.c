@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "gm-dmi.h"
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#define DMI_ID_PATH "class/dmi/id"
+
+/*
+ * Appends `str` lowercased. Runs of characters that aren't ASCII
+ * letters or digits become a single '-', leading and trailing ones
+ * are dropped.
+ */
+static void
+append_normalized (GString *out, const char *str)
+{
+  gboolean pending_sep = FALSE;
+  gsize start = out->len;
+
+  for (const char *p = str; *p; p++) {
+    if (g_ascii_isalnum (*p)) {
+      if (pending_sep && out->len > start)
+        g_string_append_c (out, '-');
+      pending_sep = FALSE;
+      g_string_append_c (out, g_ascii_tolower (*p));
+    } else {
+      pending_sep = TRUE;
+    }
+  }
+}
+
+/**
+ * gm_dmi_to_compatible:
+ * @vendor: The system vendor as found in DMI data
+ * @product: The product name as found in DMI data
+ *
+ * Builds a device tree compatible style identifier from DMI vendor
+ * and product name. Both are lowercased and runs of characters other
+ * than ASCII letters and digits are replaced by a single `-`. E.g.
+ * `"GPD"` and `"G1619-04"` result in `"gpd,g1619-04"`.
+ *
+ * This is what [class@DeviceInfo] uses to look up data for devices
+ * without a device tree.
+ *
+ * Returns:(transfer full)(nullable): The compatible or %NULL if vendor
+ *   or product are empty after normalization.
+ *
+ * Since: 0.8.0
+ */
+char *
+gm_dmi_to_compatible (const char *vendor, const char *product)
+{
+  g_autoptr (GString) compatible = NULL;
+  gsize vendor_len;
+
+  g_return_val_if_fail (vendor != NULL, NULL);
+  g_return_val_if_fail (product != NULL, NULL);
+
+  compatible = g_string_new (NULL);
+  append_normalized (compatible, vendor);
+  vendor_len = compatible->len;
+  if (vendor_len == 0)
+    return NULL;
+
+  g_string_append_c (compatible, ',');
+  append_normalized (compatible, product);
+  if (compatible->len == vendor_len + 1)
+    return NULL;
+
+  return g_string_free (g_steal_pointer (&compatible), FALSE);
+}
+
+
+static char *
+read_dmi_attr (const char *sysfs_root, const char *attr, GError **err)
+{
+  g_autofree char *path = NULL;
+  g_autoptr (GError) local_err = NULL;
+  char *contents;
+
+  path = g_build_filename (sysfs_root ?: "/sys", DMI_ID_PATH, attr, NULL);
+  if (!g_file_get_contents (path, &contents, NULL, &local_err)) {
+    if (g_error_matches (local_err, G_FILE_ERROR, G_FILE_ERROR_NOENT)) {
+      g_set_error (err, G_IO_ERROR, G_IO_ERROR_NOT_FOUND, "%s not found", path);
+    } else {
+      g_propagate_error (err, g_steal_pointer (&local_err));
+    }
+    return NULL;
+  }
+
+  return g_strstrip (contents);
+}
+
+/**
+ * gm_dmi_get_compatible:
+ * @sysfs_root:(nullable): Path where /sys is mounted. Defaults to `/sys` if %NULL is passed.
+ * @err: return location for error or %NULL
+ *
+ * Reads the system vendor and product name from
+ * `sysfs_root/class/dmi/id/` and turns them into a device tree
+ * compatible style identifier, see [func@dmi_to_compatible].
+ *
+ * Returns:(transfer full)(nullable): The compatible or %NULL on error
+ *
+ * Since: 0.8.0
+ */
+char *
+gm_dmi_get_compatible (const char *sysfs_root, GError **err)
+{
+  g_autofree char *vendor = NULL;
+  g_autofree char *product = NULL;
+  char *compatible;
+
+  g_return_val_if_fail (err == NULL || *err == NULL, NULL);
+
+  vendor = read_dmi_attr (sysfs_root, "sys_vendor", err);
+  if (vendor == NULL)
+    return NULL;
+
+  product = read_dmi_attr (sysfs_root, "product_name", err);
+  if (product == NULL)
+    return NULL;
+
+  compatible = gm_dmi_to_compatible (vendor, product);
+  if (compatible == NULL) {
+    g_set_error (err, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                 "Unusable DMI data '%s' '%s'", vendor, product);
+  }
+
+  return compatible;
+}
+
+/**
+ * gm_dmi_get_modalias:
+ * @sysfs_root:(nullable): Path where /sys is mounted. Defaults to `/sys` if %NULL is passed.
+ * @err: return location for error or %NULL
+ *
+ * Reads the DMI modalias (`dmi:bvn…:svn…:pn…`) from
+ * `sysfs_root/class/dmi/id/modalias` as used in hwdb matches.
+ *
+ * Returns:(transfer full)(nullable): The modalias or %NULL on error
+ *
+ * Since: 0.8.0
+ */
+char *
+gm_dmi_get_modalias (const char *sysfs_root, GError **err)
+{
+  g_return_val_if_fail (err == NULL || *err == NULL, NULL);
+
+  return read_dmi_attr (sysfs_root, "modalias", err);
+}
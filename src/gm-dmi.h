@@ -0,0 +1,21 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_GMOBILE_INSIDE) && !defined(GMOBILE_COMPILATION)
+#error "Only <gmobile.h> can be included directly."
+#endif
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+char       *gm_dmi_get_compatible (const char *sysfs_root, GError **err);
+char       *gm_dmi_to_compatible  (const char *vendor, const char *product);
+char       *gm_dmi_get_modalias   (const char *sysfs_root, GError **err);
+
+G_END_DECLS
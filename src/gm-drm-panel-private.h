@@ -0,0 +1,17 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#include "gm-display-panel.h"
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+GmDisplayPanel *gm_drm_panel_probe (const char *sysfs_root);
+
+G_END_DECLS
@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "gm-drm-panel-private.h"
+#include "gm-stats-private.h"
+
+#include <gio/gio.h>
+
+#include <stdio.h>
+
+#define DRM_CLASS_PATH "class/drm"
+
+#define EDID_BLOCK_SIZE      128
+#define EDID_NAME_LEN        13
+#define EDID_DESCRIPTORS     54
+#define EDID_DESCRIPTOR_SIZE 18
+#define EDID_N_DESCRIPTORS   4
+
+/*
+ * Probe the DRM connectors in sysfs for a built-in panel. This is the
+ * fallback when there's no panel description for a device.
+ */
+
+typedef struct {
+  char *name;
+  int   x_res;
+  int   y_res;
+  int   width;
+  int   height;
+} GmDrmPanelInfo;
+
+/* Parsed EDIDs keyed by their contents */
+G_LOCK_DEFINE_STATIC (edid_cache);
+static GHashTable *edid_cache;
+
+/* Connector types that are usually built into the device */
+static const char * const internal_connectors[] = { "DSI", "eDP", "LVDS", "DPI", NULL };
+
+
+static void
+gm_drm_panel_info_free (GmDrmPanelInfo *info)
+{
+  g_free (info->name);
+  g_free (info);
+}
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (GmDrmPanelInfo, gm_drm_panel_info_free)
+
+
+static gboolean
+is_internal_connector (const char *name)
+{
+  const char *type;
+
+  /* cardN-<type>-M */
+  if (!g_str_has_prefix (name, "card"))
+    return FALSE;
+
+  type = strchr (name, '-');
+  if (type == NULL)
+    return FALSE;
+  type++;
+
+  for (int i = 0; internal_connectors[i]; i++) {
+    gsize len = strlen (internal_connectors[i]);
+
+    if (strncmp (type, internal_connectors[i], len) == 0 && type[len] == '-')
+      return TRUE;
+  }
+
+  return FALSE;
+}
+
+
+static char *
+parse_edid_name (const guint8 *descriptor)
+{
+  char name[EDID_NAME_LEN + 1];
+
+  memcpy (name, descriptor + 5, EDID_NAME_LEN);
+  name[EDID_NAME_LEN] = '\0';
+  /* The name is terminated by a newline and padded with spaces */
+  g_strdelimit (name, "\n", '\0');
+  g_strchomp (name);
+
+  return name[0] ? g_strdup (name) : NULL;
+}
+
+
+static GmDrmPanelInfo *
+parse_edid (const guint8 *edid, gsize len)
+{
+  static const guint8 header[] = { 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00 };
+  g_autoptr (GmDrmPanelInfo) info = g_new0 (GmDrmPanelInfo, 1);
+  guint8 sum = 0;
+
+  if (len < EDID_BLOCK_SIZE || memcmp (edid, header, sizeof (header)) != 0)
+    return NULL;
+
+  for (int i = 0; i < EDID_BLOCK_SIZE; i++)
+    sum += edid[i];
+  if (sum != 0)
+    return NULL;
+
+  /* Screen size in cm, refined by the detailed timing below */
+  info->width = edid[21] * 10;
+  info->height = edid[22] * 10;
+
+  for (int i = 0; i < EDID_N_DESCRIPTORS; i++) {
+    const guint8 *d = edid + EDID_DESCRIPTORS + i * EDID_DESCRIPTOR_SIZE;
+    int width_mm, height_mm;
+
+    if (d[0] == 0 && d[1] == 0) {
+      /* Display descriptor, 0xfc is the product name */
+      if (d[3] == 0xfc && info->name == NULL)
+        info->name = parse_edid_name (d);
+      continue;
+    }
+
+    /* The first detailed timing is the preferred mode */
+    if (info->x_res)
+      continue;
+
+    info->x_res = d[2] | ((d[4] & 0xf0) << 4);
+    info->y_res = d[5] | ((d[7] & 0xf0) << 4);
+    width_mm = d[12] | ((d[14] & 0xf0) << 4);
+    height_mm = d[13] | ((d[14] & 0x0f) << 8);
+    if (width_mm && height_mm) {
+      info->width = width_mm;
+      info->height = height_mm;
+    }
+  }
+
+  if (info->x_res == 0 || info->y_res == 0)
+    return NULL;
+
+  return g_steal_pointer (&info);
+}
+
+
+static GmDrmPanelInfo *
+lookup_edid (GBytes *edid)
+{
+  GmDrmPanelInfo *info, *cached;
+
+  G_LOCK (edid_cache);
+  if (edid_cache == NULL) {
+    edid_cache = g_hash_table_new_full (g_bytes_hash, g_bytes_equal,
+                                        (GDestroyNotify)g_bytes_unref,
+                                        (GDestroyNotify)gm_drm_panel_info_free);
+  }
+  cached = g_hash_table_lookup (edid_cache, edid);
+  if (cached == NULL) {
+    gsize len;
+    const guint8 *data = g_bytes_get_data (edid, &len);
+
+    cached = parse_edid (data, len);
+    if (cached)
+      g_hash_table_insert (edid_cache, g_bytes_ref (edid), cached);
+  }
+
+  info = NULL;
+  if (cached) {
+    info = g_new0 (GmDrmPanelInfo, 1);
+    *info = *cached;
+    info->name = g_strdup (cached->name);
+  }
+  G_UNLOCK (edid_cache);
+
+  return info;
+}
+
+
+/* The first (preferred) mode, e.g. `720x1440` */
+static gboolean
+parse_modes (const char *modes, int *x_res, int *y_res)
+{
+  return sscanf (modes, "%dx%d", x_res, y_res) == 2 && *x_res > 0 && *y_res > 0;
+}
+
+
+static char *
+read_attr (const char *dir, const char *attr, gsize *len)
+{
+  g_autofree char *path = g_build_filename (dir, attr, NULL);
+  char *contents;
+
+  if (!g_file_get_contents (path, &contents, len, NULL))
+    return NULL;
+
+  return contents;
+}
+
+
+static GmDrmPanelInfo *
+probe_connector (const char *path, const char *connector)
+{
+  g_autofree char *status = NULL;
+  g_autofree char *edid = NULL;
+  g_autofree char *modes = NULL;
+  GmDrmPanelInfo *info = NULL;
+  gsize len = 0;
+
+  status = read_attr (path, "status", NULL);
+  if (status && g_str_has_prefix (status, "disconnected"))
+    return NULL;
+
+  /* Prefer EDID as it has the physical size too */
+  edid = read_attr (path, "edid", &len);
+  if (edid && len) {
+    g_autoptr (GBytes) bytes = g_bytes_new_take (g_steal_pointer (&edid), len);
+
+    info = lookup_edid (bytes);
+  }
+
+  if (info == NULL) {
+    int x_res, y_res;
+
+    /* Built-in panels (e.g. DSI) often don't have an EDID */
+    modes = read_attr (path, "modes", NULL);
+    if (modes == NULL || !parse_modes (modes, &x_res, &y_res))
+      return NULL;
+
+    info = g_new0 (GmDrmPanelInfo, 1);
+    info->x_res = x_res;
+    info->y_res = y_res;
+  }
+
+  if (info->name == NULL)
+    info->name = g_strdup (connector);
+
+  return info;
+}
+
+
+static int
+compare_names (gconstpointer a, gconstpointer b)
+{
+  return g_strcmp0 (*(const char * const *)a, *(const char * const *)b);
+}
+
+/**
+ * gm_drm_panel_probe:
+ * @sysfs_root:(nullable): Path where /sys is mounted. Defaults to `/sys` if %NULL is passed.
+ *
+ * Looks for a built-in panel (DSI, eDP, LVDS or DPI connector) in
+ * `sysfs_root/class/drm` and builds a panel from its EDID's preferred
+ * detailed timing and physical size. If there's no EDID the preferred
+ * mode is used and the physical size is unknown (`0`).
+ *
+ * Parsed EDIDs are cached until [func@trim] is called.
+ *
+ * Returns:(transfer full)(nullable): The panel or %NULL if no built-in panel was found
+ */
+GmDisplayPanel *
+gm_drm_panel_probe (const char *sysfs_root)
+{
+  g_autofree char *drm_path = NULL;
+  g_autoptr (GPtrArray) connectors = NULL;
+  g_autoptr (GDir) dir = NULL;
+  const char *name;
+
+  drm_path = g_build_filename (sysfs_root ?: "/sys", DRM_CLASS_PATH, NULL);
+  dir = g_dir_open (drm_path, 0, NULL);
+  if (dir == NULL)
+    return NULL;
+
+  connectors = g_ptr_array_new_with_free_func (g_free);
+  while ((name = g_dir_read_name (dir))) {
+    if (is_internal_connector (name))
+      g_ptr_array_add (connectors, g_strdup (name));
+  }
+  /* Make the result independent of the directory order */
+  g_ptr_array_sort (connectors, compare_names);
+
+  for (guint i = 0; i < connectors->len; i++) {
+    const char *connector = g_ptr_array_index (connectors, i);
+    g_autofree char *path = g_build_filename (drm_path, connector, NULL);
+    g_autoptr (GmDrmPanelInfo) info = probe_connector (path, connector);
+
+    if (info == NULL)
+      continue;
+
+    g_debug ("Using panel info from %s: %dx%d, %dx%dmm", connector,
+             info->x_res, info->y_res, info->width, info->height);
+
+    return g_object_new (GM_TYPE_DISPLAY_PANEL,
+                         "name", info->name,
+                         "x-res", info->x_res,
+                         "y-res", info->y_res,
+                         "width", info->width,
+                         "height", info->height,
+                         NULL);
+  }
+
+  return NULL;
+}
+
+
+guint
+gm_drm_panel_get_cache_stats (gsize *size)
+{
+  GHashTableIter iter;
+  gpointer key, value;
+  guint n = 0;
+
+  *size = 0;
+
+  G_LOCK (edid_cache);
+  if (edid_cache) {
+    g_hash_table_iter_init (&iter, edid_cache);
+    while (g_hash_table_iter_next (&iter, &key, &value)) {
+      GmDrmPanelInfo *info = value;
+
+      *size += g_bytes_get_size (key) + sizeof (GmDrmPanelInfo);
+      if (info->name)
+        *size += strlen (info->name) + 1;
+      n++;
+    }
+  }
+  G_UNLOCK (edid_cache);
+
+  return n;
+}
+
+
+void
+gm_drm_panel_trim_cache (void)
+{
+  G_LOCK (edid_cache);
+  g_clear_pointer (&edid_cache, g_hash_table_destroy);
+  G_UNLOCK (edid_cache);
+}
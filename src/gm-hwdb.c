@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "gm-hwdb.h"
+
+#include <fnmatch.h>
+
+/*
+ * gmobile's hwdb files are compiled into the library too so their
+ * properties can be looked up without a round trip through udev, e.g.
+ * in containers or tests.
+ */
+
+/*
+ * A trie node over the literal prefixes of the match patterns. The
+ * children of a node are stored next to each other sorted by their
+ * character. `first_match` and `n_matches` refer to the patterns
+ * whose literal prefix ends at this node.
+ */
+typedef struct {
+  char    c;
+  guint16 first_child;
+  guint16 n_children;
+  guint16 first_match;
+  guint16 n_matches;
+} GmHwdbNode;
+
+/* The rest of a pattern starting at its first glob character */
+typedef struct {
+  const char *glob;
+  guint16     record;
+} GmHwdbMatch;
+
+/* Records are in file and line order */
+typedef struct {
+  guint16 first_property;
+  guint16 n_properties;
+} GmHwdbRecord;
+
+typedef struct {
+  const char *name;
+  const char *value;
+} GmHwdbProperty;
+
+/* Generated at build time from the hwdb files in data/ */
+#include "gm-hwdb-data.h"
+
+typedef void (*GmHwdbMatchFunc) (const GmHwdbRecord *record, gpointer user_data);
+
+
+static const GmHwdbNode *
+find_child (const GmHwdbNode *node, char c)
+{
+  guint lo = node->first_child, hi = node->first_child + node->n_children;
+
+  while (lo < hi) {
+    guint mid = lo + (hi - lo) / 2;
+
+    if (hwdb_nodes[mid].c == c)
+      return &hwdb_nodes[mid];
+
+    if (hwdb_nodes[mid].c < c)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return NULL;
+}
+
+/*
+ * Calls `func` for every record matching `modalias`. The records
+ * aren't reported in any particular order.
+ */
+static void
+foreach_match (const char *modalias, GmHwdbMatchFunc func, gpointer user_data)
+{
+  const GmHwdbNode *node = &hwdb_nodes[0];
+  const char *p = modalias;
+
+  while (node) {
+    for (guint i = node->first_match; i < node->first_match + node->n_matches; i++) {
+      if (fnmatch (hwdb_matches[i].glob, p, 0) == 0)
+        func (&hwdb_records[hwdb_matches[i].record], user_data);
+    }
+
+    if (*p == '\0')
+      break;
+
+    node = find_child (node, *p);
+    p++;
+  }
+}
+
+
+typedef struct {
+  const char           *name;
+  const GmHwdbRecord   *record;
+  const GmHwdbProperty *property;
+} GetPropertyData;
+
+
+static void
+get_property_cb (const GmHwdbRecord *record, gpointer user_data)
+{
+  GetPropertyData *data = user_data;
+
+  /* Later records win */
+  if (data->record && data->record > record)
+    return;
+
+  for (guint i = record->first_property; i < record->first_property + record->n_properties; i++) {
+    if (g_str_equal (hwdb_properties[i].name, data->name)) {
+      data->record = record;
+      data->property = &hwdb_properties[i];
+    }
+  }
+}
+
+/**
+ * gm_hwdb_get_property:
+ * @modalias: The lookup key, e.g. `gmobile:name:gpio-keys:dt:purism,librem5r4`
+ * @name: The property's name, e.g. `GM_WAKEUP_KEY_114`
+ *
+ * Looks up a property in gmobile's hwdb data (`61-gmobile-*.hwdb`)
+ * without going through udev. `modalias` is built like the udev rules
+ * do:
+ *
+ * - `gmobile:atkbd:<dmi modalias>` for AT keyboards
+ * - `gmobile:name:<input device name>:<dmi modalias>`
+ * - `gmobile:name:<input device or LED name>:dt:<first compatible>`
+ *
+ * If several matching entries set the property the one from the later
+ * file or line wins. This doesn't allocate any memory.
+ *
+ * Returns:(nullable): The property's value or %NULL if no entry
+ *   matching `modalias` sets it
+ *
+ * Since: 0.8.0
+ */
+const char *
+gm_hwdb_get_property (const char *modalias, const char *name)
+{
+  GetPropertyData data = { .name = name };
+
+  g_return_val_if_fail (modalias, NULL);
+  g_return_val_if_fail (name, NULL);
+
+  foreach_match (modalias, get_property_cb, &data);
+
+  return data.property ? data.property->value : NULL;
+}
+
+
+static void
+collect_record_cb (const GmHwdbRecord *record, gpointer user_data)
+{
+  GPtrArray *records = user_data;
+
+  g_ptr_array_add (records, (gpointer)record);
+}
+
+
+static int
+compare_records (gconstpointer a, gconstpointer b)
+{
+  const GmHwdbRecord *ra = *(const GmHwdbRecord **)a;
+  const GmHwdbRecord *rb = *(const GmHwdbRecord **)b;
+
+  return (ra > rb) - (ra < rb);
+}
+
+/**
+ * gm_hwdb_get_properties:
+ * @modalias: The lookup key, e.g. `gmobile:name:gpio-keys:dt:purism,librem5r4`
+ *
+ * Looks up all properties in gmobile's hwdb data that apply to
+ * `modalias`.
+ *
+ * Returns:(transfer container)(element-type utf8 utf8): The properties
+ *   and their values
+ *
+ * Since: 0.8.0
+ */
+GHashTable *
+gm_hwdb_get_properties (const char *modalias)
+{
+  g_autoptr (GPtrArray) records = g_ptr_array_new ();
+  GHashTable *properties;
+
+  g_return_val_if_fail (modalias, NULL);
+
+  properties = g_hash_table_new (g_str_hash, g_str_equal);
+
+  foreach_match (modalias, collect_record_cb, records);
+  g_ptr_array_sort (records, compare_records);
+
+  for (guint i = 0; i < records->len; i++) {
+    const GmHwdbRecord *record = g_ptr_array_index (records, i);
+
+    for (guint j = record->first_property; j < record->first_property + record->n_properties; j++) {
+      g_hash_table_insert (properties,
+                           (gpointer)hwdb_properties[j].name,
+                           (gpointer)hwdb_properties[j].value);
+    }
+  }
+
+  return properties;
+}
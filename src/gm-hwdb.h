@@ -0,0 +1,20 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_GMOBILE_INSIDE) && !defined(GMOBILE_COMPILATION)
+#error "Only <gmobile.h> can be included directly."
+#endif
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+const char *gm_hwdb_get_property   (const char *modalias, const char *name);
+GHashTable *gm_hwdb_get_properties (const char *modalias);
+
+G_END_DECLS
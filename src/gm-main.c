@@ -7,28 +7,20 @@
  */
 
 #include "gm-main.h"
-#include "gm-resources.h"
 
 /**
  * gm_init:
  *
- * Call this function to initialize the library explicitly. This makes
- * the embedded device information available.
+ * Call this function to initialize the library explicitly.
+ *
+ * The embedded device information is registered on first use (e.g. by
+ * [class@DeviceInfo] or [ctor@DisplayPanel.new_from_resource]) so
+ * processes that don't need it don't pay for it.
  *
  * Since: 0.0.1
  */
 void
 gm_init (void)
 {
-  static gsize initialized = FALSE;
-
-  if (g_once_init_enter (&initialized)) {
-    /*
-     * gmobile is currently meant as static library so register
-     * resources explicitly.  otherwise they get dropped during static
-     * linking
-     */
-    gm_register_resource ();
-    g_once_init_leave (&initialized, TRUE);
-  }
+  /* Nothing to do (yet) */
 }
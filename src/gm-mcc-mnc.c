@@ -14,256 +14,252 @@
 
 #include <gio/gio.h>
 
-struct mcc_list {
+/* Generated at build time from data/mcc.txt */
+#include "gm-mcc-tables.h"
+
+#define MCC_LEN 3
+
+
+static guint
+get_isos_offset (guint mcc)
+{
+  if (mcc >= G_N_ELEMENTS (mcc_isos_offset))
+    return 0;
+
+  return mcc_isos_offset[mcc];
+}
+
+
+static gboolean
+parse_mcc (const char *str, gssize len, guint *mcc)
+{
+  guint num = 0;
+
+  if (str == NULL || (len >= 0 && len < MCC_LEN))
+    return FALSE;
+
+  /* The digit check also stops at a terminating NUL */
+  for (int i = 0; i < MCC_LEN; i++) {
+    if (!g_ascii_isdigit (str[i]))
+      return FALSE;
+    num = num * 10 + (str[i] - '0');
+  }
+
+  *mcc = num;
+  return TRUE;
+}
+
+/**
+ * gm_mcc_num_to_isos:
+ * @mcc: The mobile country code as number, e.g. `340`
+ *
+ * Get all ISO 3166-1 country codes for the given mobile country code
+ * (MCC). Some MCCs are shared by several countries or geographic areas,
+ * e.g. `340` is used by Guadeloupe (`GP`) and Martinique (`MQ`).
+ *
+ * This doesn't allocate any memory.
+ *
+ * Returns:(nullable)(transfer none)(array zero-terminated=1): The
+ *   country codes or %NULL if the MCC is unknown
+ *
+ * Since: 0.8.0
+ */
+const char * const *
+gm_mcc_num_to_isos (guint mcc)
+{
+  guint offset = get_isos_offset (mcc);
+
+  return offset ? &mcc_isos[offset] : NULL;
+}
+
+/**
+ * gm_mcc_str_to_isos:
+ * @str: A string starting with the mobile country code, e.g. an IMSI
+ * @len: The length of `str` or -1 if it is `NUL` terminated
+ *
+ * Like [func@mcc_num_to_isos] but takes the MCC as string like
+ * [func@mcc_str_to_iso].
+ *
+ * Returns:(nullable)(transfer none)(array zero-terminated=1): The
+ *   country codes or %NULL if the MCC is invalid or unknown
+ *
+ * Since: 0.8.0
+ */
+const char * const *
+gm_mcc_str_to_isos (const char *str, gssize len)
+{
   guint mcc;
-  char  code[3];
-};
 
-/*
- * Extracted from:
- * https://www.itu.int/dms_pub/itu-t/opb/sp/T-SP-E.212B-2018-PDF-E.pdf
+  if (!parse_mcc (str, len, &mcc))
+    return NULL;
+
+  return gm_mcc_num_to_isos (mcc);
+}
+
+/**
+ * gm_mcc_iso_to_mccs:
+ * @iso: An ISO 3166-1 alpha-2 country code, e.g. `CH`
+ * @n_mccs:(out): Return location for the number of MCCs
+ *
+ * Get the mobile country codes (MCC) used in the given country or
+ * geographic area. Most countries have a single MCC but e.g. the `US`
+ * have several. The country code is matched case insensitively.
+ *
+ * This doesn't allocate any memory and takes constant time.
+ *
+ * Returns:(nullable)(transfer none)(array length=n_mccs): The sorted
+ *   MCCs or %NULL if the country code is invalid or unknown
+ *
+ * Since: 0.8.0
+ */
+const guint16 *
+gm_mcc_iso_to_mccs (const char *iso, guint *n_mccs)
+{
+  guint slot;
+
+  g_return_val_if_fail (n_mccs, NULL);
+
+  *n_mccs = 0;
+  if (iso == NULL || !g_ascii_isalpha (iso[0]) || !g_ascii_isalpha (iso[1]) || iso[2] != '\0')
+    return NULL;
+
+  slot = (g_ascii_toupper (iso[0]) - 'A') * 26 + (g_ascii_toupper (iso[1]) - 'A');
+  *n_mccs = iso_mccs_offset[slot + 1] - iso_mccs_offset[slot];
+
+  return *n_mccs ? &iso_mccs[iso_mccs_offset[slot]] : NULL;
+}
+
+/**
+ * gm_mcc_num_to_iso:
+ * @mcc: The mobile country code as number, e.g. `228`
+ *
+ * Get the ISO 3166-1 country code for the given mobile country code
+ * (MCC). Unlike [func@mcc_to_iso] this doesn't allocate any memory and
+ * is meant for hot paths.
+ *
+ * If the MCC is shared the first listed country is returned, see
+ * [func@mcc_num_to_isos] to get all of them.
+ *
+ * Returns:(nullable): The country code or %NULL if the MCC is unknown
+ *
+ * Since: 0.8.0
  */
-struct mcc_list mcc_list[] = {
-  {202, "GR"},
-  {204, "NL"},
-  {206, "BE"},
-  {208, "FR"},
-  {212, "MC"},
-  {213, "AD"},
-  {214, "ES"},
-  {216, "HU"},
-  {218, "BA"},
-  {219, "HR"},
-  {220, "RS"},
-  {221, "XK"},
-  {222, "IT"},
-  {225, "VA"},
-  {226, "RO"},
-  {228, "CH"},
-  {230, "CZ"},
-  {231, "SK"},
-  {232, "AT"},
-  {234, "GB"},
-  {235, "GB"},
-  {238, "DK"},
-  {240, "SE"},
-  {242, "NO"},
-  {244, "FI"},
-  {246, "LT"},
-  {247, "LV"},
-  {248, "EE"},
-  {250, "RU"},
-  {255, "UA"},
-  {257, "BY"},
-  {259, "MD"},
-  {260, "PL"},
-  {262, "DE"},
-  {266, "GI"},
-  {268, "PT"},
-  {270, "LU"},
-  {272, "IE"},
-  {274, "IS"},
-  {276, "AL"},
-  {278, "MT"},
-  {280, "CY"},
-  {282, "GE"},
-  {283, "AM"},
-  {284, "BG"},
-  {286, "TR"},
-  {288, "FO"},
-  {290, "GL"},
-  {292, "SM"},
-  {293, "SI"},
-  {294, "MK"},
-  {295, "LI"},
-  {297, "ME"},
-  {302, "CA"},
-  {308, "PM"},
-  {310, "US"},
-  {311, "US"},
-  {312, "US"},
-  {313, "US"},
-  {314, "US"},
-  {315, "US"},
-  {316, "US"},
-  {330, "PR"},
-  {332, "VI"},
-  {334, "MX"},
-  {338, "JM"},
-  /* Guadeloupe and Martinique are part of France */
-  {340, "GP"},
-  {340, "MQ"},
-  {342, "BB"},
-  {344, "AG"},
-  {346, "KY"},
-  {348, "VG"},
-  {350, "BM"},
-  {352, "GD"},
-  {354, "MS"},
-  {356, "KN"},
-  {358, "LC"},
-  {360, "VC"},
-  {362, "CW"},
-  {363, "AW"},
-  {364, "BS"},
-  {365, "AI"},
-  {366, "DM"},
-  {368, "CU"},
-  {370, "DO"},
-  {372, "HT"},
-  {374, "TT"},
-  {376, "TC"},
-  {400, "AZ"},
-  {401, "KZ"},
-  {402, "BT"},
-  {404, "IN"},
-  {405, "IN"},
-  {406, "IN"},
-  {410, "PK"},
-  {412, "AF"},
-  {413, "LK"},
-  {414, "MM"},
-  {415, "LB"},
-  {416, "JO"},
-  {417, "SY"},
-  {418, "IQ"},
-  {419, "KW"},
-  {420, "SA"},
-  {421, "YE"},
-  {422, "OM"},
-  {424, "AE"},
-  {425, "IL"},
-  {426, "BH"},
-  {427, "QA"},
-  {428, "MN"},
-  {429, "NP"},
-  {430, "AE"},
-  {431, "AE"},
-  {432, "IR"},
-  {434, "UZ"},
-  {436, "TJ"},
-  {437, "KG"},
-  {438, "TM"},
-  {440, "JP"},
-  {441, "JP"},
-  {450, "KP"},
-  {452, "VN"},
-  {454, "HK"},
-  {455, "MO"},
-  {456, "KH"},
-  {457, "LA"},
-  {460, "CN"},
-  {461, "CN"},
-  {466, "TW"},
-  {467, "KR"},
-  {470, "BD"},
-  {472, "MV"},
-  {502, "MY"},
-  {505, "AU"},
-  {510, "ID"},
-  {514, "TL"},
-  {515, "PH"},
-  {520, "TH"},
-  {525, "SG"},
-  {528, "BN"},
-  {530, "NZ"},
-  {536, "NR"},
-  {537, "PG"},
-  {539, "TO"},
-  {540, "SB"},
-  {541, "VU"},
-  {542, "FJ"},
-  {543, "WF"},
-  {544, "AS"},
-  {545, "KI"},
-  {546, "NC"},
-  {547, "PF"},
-  {548, "CK"},
-  {549, "AS"},
-  {550, "FM"},
-  {551, "MH"},
-  {552, "PW"},
-  {553, "TV"},
-  {554, "TK"},
-  {555, "NU"},
-  {602, "EG"},
-  {603, "DZ"},
-  {604, "MA"},
-  {605, "TN"},
-  {606, "LY"},
-  {607, "GM"},
-  {608, "SN"},
-  {609, "MR"},
-  {610, "ML"},
-  {611, "GN"},
-  {612, "CI"},
-  {613, "BF"},
-  {614, "NE"},
-  {615, "TG"},
-  {616, "BJ"},
-  {617, "MU"},
-  {618, "LR"},
-  {619, "SL"},
-  {620, "GH"},
-  {621, "NG"},
-  {622, "TD"},
-  {623, "CF"},
-  {624, "CM"},
-  {625, "CV"},
-  {626, "ST"},
-  {627, "GQ"},
-  {628, "GA"},
-  {629, "CG"},
-  {630, "CD"},
-  {631, "AO"},
-  {632, "GW"},
-  {633, "SC"},
-  {634, "SD"},
-  {635, "RW"},
-  {636, "ET"},
-  {637, "SO"},
-  {638, "DJ"},
-  {639, "KE"},
-  {640, "TZ"},
-  {641, "UG"},
-  {642, "BI"},
-  {643, "MZ"},
-  {645, "ZM"},
-  {646, "MG"},
-  {647, "RE"},
-  {648, "ZW"},
-  {649, "NA"},
-  {650, "MW"},
-  {651, "LS"},
-  {652, "BW"},
-  {653, "SZ"},
-  {654, "KM"},
-  {655, "ZA"},
-  {657, "ER"},
-  {658, "SH"},
-  {659, "SS"},
-  {702, "BZ"},
-  {704, "GT"},
-  {706, "SV"},
-  {708, "HN"},
-  {710, "NI"},
-  {712, "CR"},
-  {714, "PA"},
-  {716, "PE"},
-  {722, "AR"},
-  {724, "BR"},
-  {730, "CL"},
-  {732, "CO"},
-  {734, "VE"},
-  {736, "BO"},
-  {738, "GY"},
-  {740, "EC"},
-  {742, "GF"},
-  {744, "PY"},
-  {746, "SR"},
-  {748, "UY"},
-  {750, "FK"},
-};
+const char *
+gm_mcc_num_to_iso (guint mcc)
+{
+  return mcc_isos[get_isos_offset (mcc)];
+}
+
+/**
+ * gm_mcc_str_to_iso:
+ * @str: A string starting with the mobile country code, e.g. an IMSI
+ * @len: The length of `str` or -1 if it is `NUL` terminated
+ *
+ * Get the ISO 3166-1 country code for the mobile country code (MCC)
+ * at the start of `str`. The MCC must be three ASCII digits. `str`
+ * doesn't need to be `NUL` terminated if `len` is given.
+ *
+ * Unlike [func@mcc_to_iso] this doesn't allocate any memory and is
+ * meant for hot paths.
+ *
+ * Returns:(nullable): The country code or %NULL if the MCC is invalid
+ *   or unknown
+ *
+ * Since: 0.8.0
+ */
+const char *
+gm_mcc_str_to_iso (const char *str, gssize len)
+{
+  guint mcc;
+
+  if (!parse_mcc (str, len, &mcc))
+    return NULL;
+
+  return gm_mcc_num_to_iso (mcc);
+}
+
+/**
+ * gm_mcc_get_n_countries:
+ *
+ * Gets the number of countries known to [func@mcc_classify]. Valid
+ * country indices range from 1 to the returned value.
+ *
+ * Returns: The number of countries
+ *
+ * Since: 0.8.0
+ */
+guint
+gm_mcc_get_n_countries (void)
+{
+  return G_N_ELEMENTS (mcc_countries) - 1;
+}
+
+/**
+ * gm_mcc_country_index_to_iso:
+ * @index: A country index as returned by [func@mcc_classify]
+ *
+ * Gets the ISO 3166-1 country code for a country index. Country
+ * indices are only meaningful within the same version of gmobile so
+ * don't store them.
+ *
+ * Returns:(nullable): The country code or %NULL if the index is 0 or
+ *   out of range
+ *
+ * Since: 0.8.0
+ */
+const char *
+gm_mcc_country_index_to_iso (guint index)
+{
+  if (index >= G_N_ELEMENTS (mcc_countries))
+    return NULL;
+
+  return mcc_countries[index];
+}
+
+/**
+ * gm_mcc_classify:
+ * @strs:(array length=n_strs): `NUL` terminated strings starting with a
+ *   mobile country code like IMSIs or PLMN IDs
+ * @n_strs: The number of strings
+ * @indices:(array length=n_strs)(out caller-allocates): Return location
+ *   for the country indices
+ *
+ * Classifies many strings by country at once. For each string the
+ * index of the country its mobile country code (MCC) belongs to is
+ * stored in `indices`, 0 if the MCC is invalid or unknown. `NULL`
+ * strings are allowed and classified as unknown. Use
+ * [func@mcc_country_index_to_iso] to get the country code for an
+ * index. As with [func@mcc_str_to_iso] the first country is used for
+ * shared MCCs.
+ *
+ * This doesn't allocate any memory and is meant for bulk imports.
+ *
+ * Returns: The number of strings with a known country
+ *
+ * Since: 0.8.0
+ */
+guint
+gm_mcc_classify (const char * const *strs, gsize n_strs, guint16 *indices)
+{
+  guint n_found = 0;
+
+  g_return_val_if_fail (strs || n_strs == 0, 0);
+  g_return_val_if_fail (indices || n_strs == 0, 0);
+
+  for (gsize i = 0; i < n_strs; i++) {
+    guint16 index = 0;
+    guint mcc;
+
+    /* parse_mcc () only returns valid three digit numbers */
+    if (parse_mcc (strs[i], -1, &mcc))
+      index = mcc_country_index[mcc];
+
+    indices[i] = index;
+    n_found += index != 0;
+  }
+
+  return n_found;
+}
 
 /**
  * gm_mcc_to_iso:
@@ -276,6 +272,9 @@ struct mcc_list mcc_list[] = {
  *
  * On error `NULL` is returned and `error` is set.
  *
+ * See [func@mcc_str_to_iso] for a variant that doesn't allocate on
+ * error.
+ *
  * Returns: The country code or NULL.
  *
  * Since: 0.4.0
@@ -283,22 +282,13 @@ struct mcc_list mcc_list[] = {
 const char *
 gm_mcc_to_iso (const char *mcc, GError **err)
 {
-  g_autofree char *str = NULL;
-  guint64 num;
+  const char *iso;
 
-  if (!mcc || strlen (mcc) < 3) {
-    g_set_error (err, GM_ERROR, G_IO_ERROR_NOT_FOUND, "Invalid MCC code: %s", mcc);
+  iso = gm_mcc_str_to_iso (mcc, -1);
+  if (iso == NULL) {
+    g_set_error (err, GM_ERROR, G_IO_ERROR_NOT_FOUND, "Invalid MCC code: %.3s", mcc ?: "");
     return NULL;
   }
 
-  str = g_strndup (mcc, 3);
-  num = g_ascii_strtoull (str, NULL, 10);
-
-  for (guint i = 0; i < G_N_ELEMENTS (mcc_list); i++)
-    if (mcc_list[i].mcc == num)
-      return mcc_list[i].code;
-
-  g_set_error (err, GM_ERROR, G_IO_ERROR_NOT_FOUND, "Invalid MCC code: %" G_GUINT64_FORMAT, num);
-
-  return NULL;
+  return iso;
 }
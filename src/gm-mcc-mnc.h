@@ -10,6 +10,17 @@
 
 G_BEGIN_DECLS
 
-const char * gm_mcc_to_iso (const char *mcc, GError **err);
+const char *        gm_mcc_to_iso      (const char *mcc, GError **err);
+const char *        gm_mcc_str_to_iso  (const char *str, gssize len);
+const char *        gm_mcc_num_to_iso  (guint mcc);
+const char * const *gm_mcc_str_to_isos (const char *str, gssize len);
+const char * const *gm_mcc_num_to_isos (guint mcc);
+const guint16 *     gm_mcc_iso_to_mccs (const char *iso, guint *n_mccs);
+
+guint               gm_mcc_get_n_countries      (void);
+const char *        gm_mcc_country_index_to_iso (guint               index);
+guint               gm_mcc_classify             (const char * const *strs,
+                                                 gsize               n_strs,
+                                                 guint16            *indices);
 
 G_END_DECLS
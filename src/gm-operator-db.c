@@ -0,0 +1,432 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "gm-config.h"
+
+#include "gm-operator-db.h"
+#include "gm-stats-private.h"
+
+#include <gio/gio.h>
+
+#include <string.h>
+
+/**
+ * GmOperatorDb:
+ *
+ * A database mapping mobile country and network codes (MCC and MNC)
+ * to operators.
+ *
+ * The database is generated at build time from
+ * [mobile-broadband-provider-info](https://gitlab.gnome.org/GNOME/mobile-broadband-provider-info)
+ * by `build-aux/gen-operator-db.py`. It's a trie over the digits of
+ * MCC and MNC in a compact binary format that is memory mapped and
+ * used as is, so loading it is cheap and lookups don't allocate.
+ *
+ * Since: 0.8.0
+ */
+
+#define OPERATOR_DB_MAGIC "GMOPDB\0\0"
+#define OPERATOR_DB_VERSION 1
+#define MCC_LEN 3
+#define MAX_MNC_LEN 3
+
+/* The on disk format, see build-aux/gen-operator-db.py. All fields are little endian */
+typedef struct {
+  char    magic[8];
+  guint32 version;
+  guint32 n_nodes;
+  guint32 n_operators;
+  guint32 strings_size;
+} DbHeader;
+
+typedef struct {
+  guint16 children;
+  guint16 operator;
+  guint32 first_child;
+} DbNode;
+
+typedef struct {
+  guint32 name;
+  char    country[2];
+  guint8  flags;
+  guint8  mnc_len;
+} DbOperator;
+
+G_STATIC_ASSERT (sizeof (DbHeader) == 24);
+G_STATIC_ASSERT (sizeof (DbNode) == 8);
+G_STATIC_ASSERT (sizeof (DbOperator) == 8);
+
+struct _GmOperatorDb {
+  GBytes           *bytes;
+  const DbNode     *nodes;
+  guint             n_nodes;
+  const DbOperator *operators;
+  guint             n_operators;
+  const char       *strings;
+};
+
+G_DEFINE_BOXED_TYPE (GmOperatorDb, gm_operator_db, gm_operator_db_ref, gm_operator_db_unref)
+
+G_LOCK_DEFINE_STATIC (default_db);
+static GmOperatorDb *default_db;
+static GError *default_error;
+static gboolean loaded;
+
+
+static void
+operator_db_free (gpointer data)
+{
+  GmOperatorDb *self = data;
+
+  g_bytes_unref (self->bytes);
+}
+
+/* Children of a node are stored consecutively in digit order */
+static inline guint
+get_child (const DbNode *node, guint digit)
+{
+  guint16 children = GUINT16_FROM_LE (node->children);
+
+  return GUINT32_FROM_LE (node->first_child) +
+    __builtin_popcount (children & ((1u << digit) - 1));
+}
+
+/*
+ * Check everything lookups rely on once so they can use the data
+ * without further bounds checks.
+ */
+static gboolean
+validate (GmOperatorDb *self, guint32 strings_size, GError **err)
+{
+  if (strings_size == 0 || self->strings[strings_size - 1] != '\0')
+    goto invalid;
+
+  for (guint i = 0; i < self->n_nodes; i++) {
+    const DbNode *node = &self->nodes[i];
+    guint16 children = GUINT16_FROM_LE (node->children);
+    guint32 first_child = GUINT32_FROM_LE (node->first_child);
+
+    if (GUINT16_FROM_LE (node->operator) > self->n_operators)
+      goto invalid;
+
+    if (children == 0)
+      continue;
+
+    /* Children come after their parent so there are no cycles */
+    if (children >> 10 || first_child <= i ||
+        first_child + __builtin_popcount (children) > self->n_nodes)
+      goto invalid;
+  }
+
+  for (guint i = 0; i < self->n_operators; i++) {
+    const DbOperator *operator = &self->operators[i];
+
+    if (GUINT32_FROM_LE (operator->name) >= strings_size)
+      goto invalid;
+
+    if (!g_ascii_isupper (operator->country[0]) || !g_ascii_isupper (operator->country[1]))
+      goto invalid;
+
+    if (operator->mnc_len != 2 && operator->mnc_len != 3)
+      goto invalid;
+  }
+
+  return TRUE;
+
+ invalid:
+  g_set_error (err, G_IO_ERROR, G_IO_ERROR_INVALID_DATA, "Corrupt operator database");
+  return FALSE;
+}
+
+/**
+ * gm_operator_db_new_from_bytes:
+ * @bytes: The database
+ * @err: return location for error or %NULL
+ *
+ * Loads an operator database from `bytes`. The data isn't copied
+ * unless it is misaligned.
+ *
+ * Returns:(transfer full)(nullable): The database or %NULL on error
+ *
+ * Since: 0.8.0
+ */
+GmOperatorDb *
+gm_operator_db_new_from_bytes (GBytes *bytes, GError **err)
+{
+  g_autoptr (GmOperatorDb) self = NULL;
+  const DbHeader *header;
+  const guint8 *data;
+  guint32 strings_size;
+  gsize size, expected;
+
+  g_return_val_if_fail (bytes, NULL);
+  g_return_val_if_fail (err == NULL || *err == NULL, NULL);
+
+  self = g_atomic_rc_box_new0 (GmOperatorDb);
+  data = g_bytes_get_data (bytes, &size);
+  if (GPOINTER_TO_SIZE (data) % G_ALIGNOF (guint32)) {
+    self->bytes = g_bytes_new (data, size);
+    data = g_bytes_get_data (self->bytes, NULL);
+  } else {
+    self->bytes = g_bytes_ref (bytes);
+  }
+
+  header = (const DbHeader *)data;
+  if (size < sizeof (DbHeader) ||
+      memcmp (header->magic, OPERATOR_DB_MAGIC, sizeof (header->magic)) != 0) {
+    g_set_error (err, G_IO_ERROR, G_IO_ERROR_INVALID_DATA, "Not an operator database");
+    return NULL;
+  }
+
+  if (GUINT32_FROM_LE (header->version) != OPERATOR_DB_VERSION) {
+    g_set_error (err, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                 "Unsupported operator database version %u",
+                 GUINT32_FROM_LE (header->version));
+    return NULL;
+  }
+
+  self->n_nodes = GUINT32_FROM_LE (header->n_nodes);
+  self->n_operators = GUINT32_FROM_LE (header->n_operators);
+  strings_size = GUINT32_FROM_LE (header->strings_size);
+
+  expected = sizeof (DbHeader) + (gsize)self->n_nodes * sizeof (DbNode) +
+    (gsize)self->n_operators * sizeof (DbOperator) + strings_size;
+  if (self->n_nodes == 0 || self->n_nodes > G_MAXINT32 || self->n_operators > G_MAXUINT16 ||
+      strings_size > G_MAXINT32 || size != expected) {
+    g_set_error (err, G_IO_ERROR, G_IO_ERROR_INVALID_DATA, "Corrupt operator database");
+    return NULL;
+  }
+
+  self->nodes = (const DbNode *)(header + 1);
+  self->operators = (const DbOperator *)(self->nodes + self->n_nodes);
+  self->strings = (const char *)(self->operators + self->n_operators);
+
+  if (!validate (self, strings_size, err))
+    return NULL;
+
+  return g_steal_pointer (&self);
+}
+
+/**
+ * gm_operator_db_new_for_path:
+ * @path: The database file
+ * @err: return location for error or %NULL
+ *
+ * Memory maps the operator database at `path`.
+ *
+ * Returns:(transfer full)(nullable): The database or %NULL on error
+ *
+ * Since: 0.8.0
+ */
+GmOperatorDb *
+gm_operator_db_new_for_path (const char *path, GError **err)
+{
+  g_autoptr (GMappedFile) file = NULL;
+  g_autoptr (GBytes) bytes = NULL;
+
+  g_return_val_if_fail (path, NULL);
+  g_return_val_if_fail (err == NULL || *err == NULL, NULL);
+
+  file = g_mapped_file_new (path, FALSE, err);
+  if (file == NULL)
+    return NULL;
+
+  bytes = g_mapped_file_get_bytes (file);
+  return gm_operator_db_new_from_bytes (bytes, err);
+}
+
+/**
+ * gm_operator_db_get_default:
+ * @err: return location for error or %NULL
+ *
+ * Gets the operator database installed along with gmobile. It's
+ * loaded on first use and then kept until [func@trim] is called. If
+ * loading fails the error is remembered too.
+ *
+ * If `GMOBILE_OPERATOR_DB` is set on first use the database is
+ * loaded from that path instead.
+ *
+ * This function is thread safe.
+ *
+ * Returns:(transfer full)(nullable): The database or %NULL on error
+ *
+ * Since: 0.8.0
+ */
+GmOperatorDb *
+gm_operator_db_get_default (GError **err)
+{
+  GmOperatorDb *db = NULL;
+
+  g_return_val_if_fail (err == NULL || *err == NULL, NULL);
+
+  G_LOCK (default_db);
+
+  if (!loaded) {
+    const char *path = g_getenv ("GMOBILE_OPERATOR_DB") ?: GM_OPERATOR_DB_PATH;
+
+    default_db = gm_operator_db_new_for_path (path, &default_error);
+    loaded = TRUE;
+  }
+
+  if (default_db)
+    db = gm_operator_db_ref (default_db);
+  else
+    g_propagate_error (err, g_error_copy (default_error));
+
+  G_UNLOCK (default_db);
+
+  return db;
+}
+
+
+gsize
+gm_operator_db_get_default_size (void)
+{
+  gsize size = 0;
+
+  G_LOCK (default_db);
+  if (default_db)
+    size = sizeof (GmOperatorDb) + g_bytes_get_size (default_db->bytes);
+  G_UNLOCK (default_db);
+
+  return size;
+}
+
+
+void
+gm_operator_db_trim_default (void)
+{
+  G_LOCK (default_db);
+  g_clear_pointer (&default_db, gm_operator_db_unref);
+  g_clear_error (&default_error);
+  loaded = FALSE;
+  G_UNLOCK (default_db);
+}
+
+/**
+ * gm_operator_db_ref:
+ * @self: The database
+ *
+ * Acquires a reference. This is thread safe.
+ *
+ * Returns:(transfer full): The database
+ *
+ * Since: 0.8.0
+ */
+GmOperatorDb *
+gm_operator_db_ref (GmOperatorDb *self)
+{
+  g_return_val_if_fail (self, NULL);
+
+  return g_atomic_rc_box_acquire (self);
+}
+
+/**
+ * gm_operator_db_unref:
+ * @self: The database
+ *
+ * Releases a reference. This is thread safe.
+ *
+ * Since: 0.8.0
+ */
+void
+gm_operator_db_unref (GmOperatorDb *self)
+{
+  g_return_if_fail (self);
+
+  g_atomic_rc_box_release_full (self, operator_db_free);
+}
+
+/**
+ * gm_operator_db_get_n_operators:
+ * @self: The database
+ *
+ * Gets the number of networks (MCC and MNC combinations) in the
+ * database.
+ *
+ * Returns: The number of networks
+ *
+ * Since: 0.8.0
+ */
+guint
+gm_operator_db_get_n_operators (GmOperatorDb *self)
+{
+  g_return_val_if_fail (self, 0);
+
+  return self->n_operators;
+}
+
+/**
+ * gm_operator_db_lookup:
+ * @self: The database
+ * @mcc_mnc: A string starting with MCC and MNC like an IMSI or `22801`
+ * @len: The length of `mcc_mnc` or -1 if it is NUL terminated
+ * @info:(out caller-allocates): Return location for the operator
+ *
+ * Looks up the operator for the given MCC and MNC. As the MNC can
+ * have two or three digits any trailing digits like in an IMSI are
+ * fine. If there are operators for both the two and three digit MNC
+ * the three digit one is used.
+ *
+ * This doesn't allocate any memory and is thread safe.
+ *
+ * Returns: %TRUE if an operator was found
+ *
+ * Since: 0.8.0
+ */
+gboolean
+gm_operator_db_lookup (GmOperatorDb   *self,
+                       const char     *mcc_mnc,
+                       gssize          len,
+                       GmOperatorInfo *info)
+{
+  const DbNode *node;
+  const DbOperator *operator;
+  guint found = 0;
+  guint max_len = MCC_LEN + MAX_MNC_LEN;
+
+  g_return_val_if_fail (self, FALSE);
+  g_return_val_if_fail (mcc_mnc, FALSE);
+  g_return_val_if_fail (info, FALSE);
+
+  if (len >= 0)
+    max_len = MIN (max_len, (gsize)len);
+
+  node = &self->nodes[0];
+  /* The digit check also stops at a terminating NUL */
+  for (guint i = 0; i < max_len && g_ascii_isdigit (mcc_mnc[i]); i++) {
+    guint digit = mcc_mnc[i] - '0';
+
+    if (!(GUINT16_FROM_LE (node->children) & (1u << digit)))
+      break;
+
+    node = &self->nodes[get_child (node, digit)];
+    /* Only accept operators whose MCC and MNC we actually matched */
+    if (node->operator &&
+        self->operators[GUINT16_FROM_LE (node->operator) - 1].mnc_len == i + 1 - MCC_LEN)
+      found = GUINT16_FROM_LE (node->operator);
+  }
+
+  if (found == 0)
+    return FALSE;
+
+  operator = &self->operators[found - 1];
+  info->name = self->strings + GUINT32_FROM_LE (operator->name);
+  info->country[0] = operator->country[0];
+  info->country[1] = operator->country[1];
+  info->country[2] = '\0';
+  info->mnc_len = operator->mnc_len;
+  info->flags = operator->flags & GM_OPERATOR_FLAG_SHARED;
+
+  info->mcc = 0;
+  for (guint i = 0; i < MCC_LEN; i++)
+    info->mcc = info->mcc * 10 + (mcc_mnc[i] - '0');
+  info->mnc = 0;
+  for (guint i = MCC_LEN; i < MCC_LEN + info->mnc_len; i++)
+    info->mnc = info->mnc * 10 + (mcc_mnc[i] - '0');
+
+  return TRUE;
+}
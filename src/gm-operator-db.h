@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_GMOBILE_INSIDE) && !defined(GMOBILE_COMPILATION)
+#error "Only <gmobile.h> can be included directly."
+#endif
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+typedef struct _GmOperatorDb GmOperatorDb;
+
+/**
+ * GmOperatorFlags:
+ * @GM_OPERATOR_FLAG_NONE: No flags
+ * @GM_OPERATOR_FLAG_SHARED: Several operators (e.g. MVNOs or brands)
+ *   use this network. The name is the one of the primary operator.
+ *
+ * Flags describing an operator found via [method@OperatorDb.lookup].
+ *
+ * Since: 0.8.0
+ */
+typedef enum {
+  GM_OPERATOR_FLAG_NONE = 0,
+  GM_OPERATOR_FLAG_SHARED = 1 << 0,
+} GmOperatorFlags;
+
+/**
+ * GmOperatorInfo:
+ * @name: The operator's name
+ * @country: The ISO 3166-1 country code
+ * @mcc: The mobile country code
+ * @mnc: The mobile network code
+ * @mnc_len: The number of digits of the mobile network code, 2 or 3
+ * @flags: Additional information about the operator
+ *
+ * Information about an operator. `name` is owned by the
+ * [struct@OperatorDb] it was looked up in.
+ *
+ * Since: 0.8.0
+ */
+typedef struct _GmOperatorInfo {
+  const char      *name;
+  char             country[3];
+  guint            mcc;
+  guint            mnc;
+  guint            mnc_len;
+  GmOperatorFlags  flags;
+} GmOperatorInfo;
+
+#define GM_TYPE_OPERATOR_DB (gm_operator_db_get_type ())
+
+GType          gm_operator_db_get_type        (void) G_GNUC_CONST;
+GmOperatorDb  *gm_operator_db_new_for_path    (const char     *path,
+                                               GError        **err);
+GmOperatorDb  *gm_operator_db_new_from_bytes  (GBytes         *bytes,
+                                               GError        **err);
+GmOperatorDb  *gm_operator_db_get_default     (GError        **err);
+GmOperatorDb  *gm_operator_db_ref             (GmOperatorDb   *self);
+void           gm_operator_db_unref           (GmOperatorDb   *self);
+guint          gm_operator_db_get_n_operators (GmOperatorDb   *self);
+gboolean       gm_operator_db_lookup          (GmOperatorDb   *self,
+                                               const char     *mcc_mnc,
+                                               gssize          len,
+                                               GmOperatorInfo *info);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (GmOperatorDb, gm_operator_db_unref)
+
+G_END_DECLS
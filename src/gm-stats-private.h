@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#include "gm-stats.h"
+
+G_BEGIN_DECLS
+
+typedef enum {
+  GM_STATS_OBJECT_DISPLAY_PANEL,
+  GM_STATS_OBJECT_CUTOUT,
+  GM_STATS_OBJECT_DEVICE_INFO,
+  GM_STATS_OBJECT_TIMEOUT,
+  GM_STATS_N_OBJECTS,
+} GmStatsObject;
+
+void  gm_stats_object_added           (GmStatsObject object, gsize size);
+void  gm_stats_object_removed         (GmStatsObject object, gsize size);
+
+/* Implemented by the modules owning the caches */
+guint gm_device_tree_get_cache_stats  (gsize *size);
+void  gm_device_tree_trim_cache       (void);
+guint gm_drm_panel_get_cache_stats    (gsize *size);
+void  gm_drm_panel_trim_cache         (void);
+gsize gm_operator_db_get_default_size (void);
+void  gm_operator_db_trim_default     (void);
+
+G_END_DECLS
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "gm-stats-private.h"
+
+#include <string.h>
+
+/*
+ * Objects register themselves on construction and finalization so
+ * counting is cheap. Caches are inspected when stats are requested.
+ */
+
+static int n_objects[GM_STATS_N_OBJECTS];
+static gsize object_sizes[GM_STATS_N_OBJECTS];
+
+
+void
+gm_stats_object_added (GmStatsObject object, gsize size)
+{
+  g_atomic_int_inc (&n_objects[object]);
+  g_atomic_pointer_add (&object_sizes[object], (gssize) size);
+}
+
+
+void
+gm_stats_object_removed (GmStatsObject object, gsize size)
+{
+  g_atomic_int_add (&n_objects[object], -1);
+  g_atomic_pointer_add (&object_sizes[object], -(gssize) size);
+}
+
+
+static void
+get_object_stats (GmStatsObject object, guint *n, gsize *size)
+{
+  *n = g_atomic_int_get (&n_objects[object]);
+  *size = (gsize) g_atomic_pointer_get (&object_sizes[object]);
+}
+
+/**
+ * gm_stats_get:
+ * @stats:(out caller-allocates): Return location for the stats
+ *
+ * Gets the number and approximate size of the objects that are
+ * currently alive and of the data kept in gmobile's internal caches.
+ * Memory that can be reclaimed via [func@trim] is included.
+ *
+ * Static data like the bundled device database isn't accounted for.
+ *
+ * This function is thread safe.
+ *
+ * Since: 0.8.0
+ */
+void
+gm_stats_get (GmStats *stats)
+{
+  g_return_if_fail (stats != NULL);
+
+  memset (stats, 0, sizeof (*stats));
+
+  get_object_stats (GM_STATS_OBJECT_DISPLAY_PANEL,
+                    &stats->n_display_panels, &stats->display_panels_size);
+  get_object_stats (GM_STATS_OBJECT_CUTOUT,
+                    &stats->n_cutouts, &stats->cutouts_size);
+  get_object_stats (GM_STATS_OBJECT_DEVICE_INFO,
+                    &stats->n_device_infos, &stats->device_infos_size);
+  get_object_stats (GM_STATS_OBJECT_TIMEOUT,
+                    &stats->n_timeouts, &stats->timeouts_size);
+
+  stats->n_cached_compatibles = gm_device_tree_get_cache_stats (&stats->cached_compatibles_size);
+  stats->n_cached_edids = gm_drm_panel_get_cache_stats (&stats->cached_edids_size);
+  stats->operator_db_size = gm_operator_db_get_default_size ();
+}
+
+/**
+ * gm_trim:
+ *
+ * Drops data from gmobile's internal caches that can be recreated
+ * when needed, e.g. when the system is low on memory. This includes
+ * the device tree compatibles cached by
+ * [func@device_tree_get_cached_compatibles], parsed EDIDs and the
+ * database loaded by [func@OperatorDb.get_default]. Data is read
+ * again on next use. References handed out earlier stay valid.
+ *
+ * This function is thread safe.
+ *
+ * Since: 0.8.0
+ */
+void
+gm_trim (void)
+{
+  gm_device_tree_trim_cache ();
+  gm_drm_panel_trim_cache ();
+  gm_operator_db_trim_default ();
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_GMOBILE_INSIDE) && !defined(GMOBILE_COMPILATION)
+#error "Only <gmobile.h> can be included directly."
+#endif
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GmStats:
+ * @n_display_panels: The number of live [class@DisplayPanel] objects
+ * @display_panels_size: Their approximate size in bytes
+ * @n_cutouts: The number of live [class@Cutout] objects
+ * @cutouts_size: Their approximate size in bytes
+ * @n_device_infos: The number of live [class@DeviceInfo] objects
+ * @device_infos_size: Their approximate size in bytes
+ * @n_timeouts: The number of live timeout sources, see
+ *   [func@timeout_add_seconds_once]
+ * @timeouts_size: Their approximate size in bytes
+ * @n_cached_compatibles: The number of entries in the cache of
+ *   [func@device_tree_get_cached_compatibles]
+ * @cached_compatibles_size: The cache's approximate size in bytes
+ * @n_cached_edids: The number of parsed EDIDs cached
+ * @cached_edids_size: The cache's approximate size in bytes
+ * @operator_db_size: The size of the database kept by
+ *   [func@OperatorDb.get_default] in bytes or `0` if it's not loaded
+ *
+ * Memory used by gmobile, see [func@stats_get]. Object sizes only
+ * account for the instances, not for the strings and arrays they
+ * reference.
+ *
+ * Since: 0.8.0
+ */
+typedef struct _GmStats {
+  guint    n_display_panels;
+  gsize    display_panels_size;
+  guint    n_cutouts;
+  gsize    cutouts_size;
+  guint    n_device_infos;
+  gsize    device_infos_size;
+  guint    n_timeouts;
+  gsize    timeouts_size;
+  guint    n_cached_compatibles;
+  gsize    cached_compatibles_size;
+  guint    n_cached_edids;
+  gsize    cached_edids_size;
+  gsize    operator_db_size;
+  /*< private >*/
+  gpointer padding[8];
+} GmStats;
+
+void gm_stats_get (GmStats *stats);
+void gm_trim      (void);
+
+G_END_DECLS
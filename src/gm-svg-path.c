@@ -9,6 +9,7 @@
 #include "gm-error.h"
 #include "gm-rect.h"
 #include "gm-svg-path.h"
+#include "gm-trace-private.h"
 
 #include <math.h>
 
@@ -332,28 +333,8 @@ normalize_path (const char *path)
 }
 
 
-/**
- * gm_svg_path_get_bounding_box:
- * @path: An SVG path
- * @x1: The lower x coordinate
- * @x2: The upper x coordinate
- * @y1: The lower y coordinate
- * @y2: The upper y coordinate
- * @err: Return location for an error
- *
- * Returns the bounding box of an SVG path. As this is meant for
- * display cutouts we operate on integer (whole pixel) values.  When
- * parsing fails, `FALSE` is returned and `error` contains the error
- * information.
- *
- * Returns: `TRUE` when parsing was successful, `FALSE` otherwise.
- *
- * See https://developer.mozilla.org/en-US/docs/Web/SVG/Tutorial/Paths for path syntax introduction.
- *
- * Since: 0.0.1
- */
-gboolean
-gm_svg_path_get_bounding_box (const char *path, int *x1, int *x2, int *y1, int *y2, GError **err)
+static gboolean
+get_bounding_box (const char *path, int *x1, int *x2, int *y1, int *y2, GError **err)
 {
   g_auto (GStrv) parts = NULL;
   g_autoptr (GRegex) whitespace = NULL;
@@ -560,3 +541,35 @@ gm_svg_path_get_bounding_box (const char *path, int *x1, int *x2, int *y1, int *
   *y2 = bbox.y2;
   return TRUE;
 }
+
+/**
+ * gm_svg_path_get_bounding_box:
+ * @path: An SVG path
+ * @x1: The lower x coordinate
+ * @x2: The upper x coordinate
+ * @y1: The lower y coordinate
+ * @y2: The upper y coordinate
+ * @err: Return location for an error
+ *
+ * Returns the bounding box of an SVG path. As this is meant for
+ * display cutouts we operate on integer (whole pixel) values.  When
+ * parsing fails, `FALSE` is returned and `error` contains the error
+ * information.
+ *
+ * Returns: `TRUE` when parsing was successful, `FALSE` otherwise.
+ *
+ * See https://developer.mozilla.org/en-US/docs/Web/SVG/Tutorial/Paths for path syntax introduction.
+ *
+ * Since: 0.0.1
+ */
+gboolean
+gm_svg_path_get_bounding_box (const char *path, int *x1, int *x2, int *y1, int *y2, GError **err)
+{
+  gint64 begin = GM_TRACE_CURRENT_TIME;
+  gboolean success;
+
+  success = get_bounding_box (path, x1, x2, y1, y2, err);
+  GM_TRACE_MARK (begin, "parse-svg-path", "%s", path);
+
+  return success;
+}
@@ -7,6 +7,8 @@
  */
 
 #include "gm-timeout.h"
+#include "gm-stats-private.h"
+#include "gm-trace-private.h"
 
 #include <gio/gio.h>
 #include <glib/gstdio.h>
@@ -35,6 +37,7 @@ gm_timeout_once_prepare (GSource *source, gint *timeout)
 {
   GmTimeoutOnce *timer = (GmTimeoutOnce *)source;
   struct itimerspec time_spec = { 0 };
+  gint64 begin;
   int ret;
 
   if (timer->fd == -1)
@@ -43,6 +46,7 @@ gm_timeout_once_prepare (GSource *source, gint *timeout)
   if (timer->armed)
     return FALSE;
 
+  begin = GM_TRACE_CURRENT_TIME;
   time_spec.it_value.tv_sec = timer->timeout_ms / 1000;
   time_spec.it_value.tv_nsec = (timer->timeout_ms % 1000) * 1000;
 
@@ -55,6 +59,9 @@ gm_timeout_once_prepare (GSource *source, gint *timeout)
 	   g_source_get_name (source)?: "(null)",
 	   timer->timeout_ms / 1000);
   timer->armed = TRUE;
+  GM_TRACE_MARK (begin, "arm-timeout", "%s: %lu ms",
+                 g_source_get_name (source) ?: "(null)", timer->timeout_ms);
+  GM_TRACE_COUNTER_ADD (GM_TRACE_COUNTER_ARMED_TIMEOUTS, 1);
   /* Never wake up the source due to a timeout */
   *timeout = -1;
   return FALSE;
@@ -66,6 +73,8 @@ gm_timeout_once_dispatch (GSource     *source,
                           GSourceFunc  callback,
                           void        *data)
 {
+  gint64 begin;
+
   if (!callback) {
     g_warning ("Timeout source dispatched without callback. "
                "You must call g_source_set_callback().");
@@ -73,7 +82,9 @@ gm_timeout_once_dispatch (GSource     *source,
   }
 
   g_debug ("Dispatching %p[%s]", source, g_source_get_name (source)?: "(null)");
+  begin = GM_TRACE_CURRENT_TIME;
   callback (data);
+  GM_TRACE_MARK (begin, "dispatch-timeout", "%s", g_source_get_name (source) ?: "(null)");
 
   return G_SOURCE_REMOVE;
 }
@@ -85,6 +96,8 @@ gm_timeout_once_finalize (GSource *source)
   GmTimeoutOnce *timer = (GmTimeoutOnce *) source;
 
   g_clear_fd (&timer->fd, NULL);
+  if (timer->armed)
+    GM_TRACE_COUNTER_ADD (GM_TRACE_COUNTER_ARMED_TIMEOUTS, -1);
   timer->armed = FALSE;
 
   if (timer->tag) {
@@ -92,6 +105,8 @@ gm_timeout_once_finalize (GSource *source)
     timer->tag = NULL;
   }
 
+  gm_stats_object_removed (GM_STATS_OBJECT_TIMEOUT, sizeof (GmTimeoutOnce));
+
   g_debug ("Finalize %p[%s]", source, g_source_get_name (source)?: "(null)");
 }
 
@@ -126,6 +141,7 @@ gm_timeout_source_once_new (gulong timeout_ms, int clockid, GError **err)
   GmTimeoutOnce *timer = NULL;
 
   timer = (GmTimeoutOnce *) g_source_new (&gm_timeout_once_source_funcs, sizeof (GmTimeoutOnce));
+  gm_stats_object_added (GM_STATS_OBJECT_TIMEOUT, sizeof (GmTimeoutOnce));
   timer->timeout_ms = timeout_ms;
   g_source_set_name ((GSource *)timer, clockid_to_name (clockid));
   timer->fd = timerfd_create (clockid, 0);
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/*
+ * Tracing hooks. When built with `-Dsysprof=enabled` these emit
+ * sysprof capture marks and counters, otherwise they compile to
+ * nothing and their arguments aren't evaluated:
+ *
+ *   gint64 begin = GM_TRACE_CURRENT_TIME;
+ *   ...
+ *   GM_TRACE_MARK (begin, "read-compatibles", "%s", path);
+ */
+
+typedef enum {
+  GM_TRACE_COUNTER_ARMED_TIMEOUTS,
+  GM_TRACE_COUNTER_PARSED_PANELS,
+  GM_TRACE_N_COUNTERS,
+} GmTraceCounter;
+
+#ifdef GM_HAVE_SYSPROF
+
+#include <sysprof-capture.h>
+
+#define GM_TRACE_CURRENT_TIME SYSPROF_CAPTURE_CURRENT_TIME
+
+void gm_trace_mark        (gint64          begin_time,
+                           const char     *name,
+                           const char     *message_format,
+                           ...) G_GNUC_PRINTF (3, 4);
+void gm_trace_counter_add (GmTraceCounter  counter,
+                           int             delta);
+
+#define GM_TRACE_MARK(begin_time, name, ...) gm_trace_mark ((begin_time), (name), __VA_ARGS__)
+#define GM_TRACE_COUNTER_ADD(counter, delta) gm_trace_counter_add ((counter), (delta))
+
+#else
+
+#define GM_TRACE_CURRENT_TIME 0
+#define GM_TRACE_MARK(begin_time, name, ...) G_STMT_START { (void) (begin_time); } G_STMT_END
+#define GM_TRACE_COUNTER_ADD(counter, delta) G_STMT_START { } G_STMT_END
+
+#endif
+
+G_END_DECLS
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "gm-trace-private.h"
+
+#define GM_TRACE_GROUP "gmobile"
+
+static const struct {
+  const char *name;
+  const char *description;
+} counter_info[GM_TRACE_N_COUNTERS] = {
+  [GM_TRACE_COUNTER_ARMED_TIMEOUTS] = { "Armed timeouts", "Number of armed timeout sources" },
+  [GM_TRACE_COUNTER_PARSED_PANELS] = { "Parsed panels", "Number of parsed display panels" },
+};
+
+static int counter_values[GM_TRACE_N_COUNTERS];
+
+
+static guint
+get_first_counter_id (void)
+{
+  /* Offset by one so a first id of 0 can be stored too */
+  static gsize first_id;
+
+  if (g_once_init_enter (&first_id)) {
+    SysprofCaptureCounter counters[GM_TRACE_N_COUNTERS] = { 0 };
+    guint id = sysprof_collector_request_counters (GM_TRACE_N_COUNTERS);
+
+    for (guint i = 0; i < GM_TRACE_N_COUNTERS; i++) {
+      counters[i].id = id + i;
+      counters[i].type = SYSPROF_CAPTURE_COUNTER_INT64;
+      counters[i].value.v64 = 0;
+      g_strlcpy (counters[i].category, GM_TRACE_GROUP, sizeof (counters[i].category));
+      g_strlcpy (counters[i].name, counter_info[i].name, sizeof (counters[i].name));
+      g_strlcpy (counters[i].description, counter_info[i].description,
+                 sizeof (counters[i].description));
+    }
+    sysprof_collector_define_counters (counters, GM_TRACE_N_COUNTERS);
+
+    g_once_init_leave (&first_id, id + 1);
+  }
+
+  return first_id - 1;
+}
+
+/**
+ * gm_trace_mark:
+ * @begin_time: The start time as returned by `GM_TRACE_CURRENT_TIME`
+ * @name: The name of the mark
+ * @message_format: printf style format of the mark's message
+ * @...: The format's arguments
+ *
+ * Adds a mark spanning from `begin_time` until now to the capture.
+ * Use the `GM_TRACE_MARK` macro instead so the call compiles away
+ * when tracing is disabled.
+ */
+void
+gm_trace_mark (gint64 begin_time, const char *name, const char *message_format, ...)
+{
+  va_list args;
+
+  if (!sysprof_collector_is_active ())
+    return;
+
+  va_start (args, message_format);
+  sysprof_collector_mark_vprintf (begin_time,
+                                  SYSPROF_CAPTURE_CURRENT_TIME - begin_time,
+                                  GM_TRACE_GROUP,
+                                  name,
+                                  message_format,
+                                  args);
+  va_end (args);
+}
+
+/**
+ * gm_trace_counter_add:
+ * @counter: The counter
+ * @delta: The value to add
+ *
+ * Adds `delta` to the given counter and records its new value in the
+ * capture. Use the `GM_TRACE_COUNTER_ADD` macro instead so the call
+ * compiles away when tracing is disabled.
+ */
+void
+gm_trace_counter_add (GmTraceCounter counter, int delta)
+{
+  SysprofCaptureCounterValue value;
+  guint id;
+
+  g_return_if_fail (counter < GM_TRACE_N_COUNTERS);
+
+  /* Keep counting while inactive so values are right once a capture starts */
+  value.v64 = g_atomic_int_add (&counter_values[counter], delta) + delta;
+
+  if (!sysprof_collector_is_active ())
+    return;
+
+  id = get_first_counter_id () + counter;
+  sysprof_collector_set_counters (&id, &value, 1);
+}
@@ -6,11 +6,20 @@
  * Author: Guido Günther <agx@sigxcpu.org>
  */
 
-#include "gm-resources.h"
+#include "gm-device-index-private.h"
 #include "gm-util.h"
 
 #include <glib.h>
 
+typedef struct {
+  const char * const *names;
+  guint               pos;
+  guint               end;
+  gpointer            reserved;
+} GmRealDeviceIter;
+
+G_STATIC_ASSERT (sizeof (GmRealDeviceIter) == sizeof (GmDeviceIter));
+
 /**
  * gm_str_is_null_or_empty:
  * @x:(nullable): A null terminated string
@@ -36,7 +45,9 @@
 /**
  * gm_list_devices:
  *
- * List device tree names of known devices.
+ * List device tree names of known devices. The list is sorted. See
+ * [method@DeviceIter.init] for a way to iterate over the devices without
+ * allocating memory.
  *
  * Returns:(nullable)(transfer full):The devices
  *
@@ -45,27 +56,83 @@
 GStrv
 gm_list_devices (void)
 {
-  g_autoptr (GError) err = NULL;
-  GResource *resource = gm_get_resource ();
-  g_auto (GStrv) children = NULL;
-  g_autoptr (GStrvBuilder) builder = g_strv_builder_new ();
+  const char * const *names;
+  guint n_names;
+  GStrv devices;
+
+  names = gm_device_index_get_names (&n_names);
+  devices = g_new (char *, n_names + 1);
+  for (guint i = 0; i < n_names; i++)
+    devices[i] = g_strdup (names[i]);
+  devices[n_names] = NULL;
+
+  return devices;
+}
+
+/**
+ * gm_device_iter_init:
+ * @iter: An uninitialized device iterator
+ * @prefix:(nullable): Only iterate over devices starting with this prefix
+ *
+ * Initializes a device iterator to iterate over the device tree names
+ * of all known devices in sorted order. If `prefix` is not `NULL` only
+ * devices whose name starts with it are returned, e.g. use
+ * `"fairphone,"` to get all Fairphone devices. `prefix` is not referenced
+ * after this function returns.
+ *
+ * Iterating doesn't allocate any memory:
+ *
+ * ```c
+ * GmDeviceIter iter;
+ * const char *name;
+ *
+ * gm_device_iter_init (&iter, "fairphone,");
+ * while (gm_device_iter_next (&iter, &name))
+ *   g_print ("%s\n", name);
+ * ```
+ *
+ * Since: 0.8.0
+ */
+void
+gm_device_iter_init (GmDeviceIter *iter, const char *prefix)
+{
+  GmRealDeviceIter *ri = (GmRealDeviceIter *)iter;
+
+  g_return_if_fail (iter != NULL);
+
+  ri->names = gm_device_index_get_names (&ri->end);
+  ri->pos = 0;
+  ri->reserved = NULL;
+
+  if (!gm_str_is_null_or_empty (prefix))
+    gm_device_index_find_prefix (prefix, &ri->pos, &ri->end);
+}
 
-  children = g_resource_enumerate_children (resource,
-                                            "/mobi/phosh/gmobile/devices/display-panels/",
-                                            G_RESOURCE_LOOKUP_FLAGS_NONE,
-                                            &err);
+/**
+ * gm_device_iter_next:
+ * @iter: An initialized device iterator
+ * @name:(out)(optional)(transfer none): The device name
+ *
+ * Advances the iterator and returns the next device name. The name is
+ * owned by gmobile and valid for the lifetime of the process.
+ *
+ * Returns: %FALSE if the end of the list has been reached otherwise %TRUE
+ *
+ * Since: 0.8.0
+ */
+gboolean
+gm_device_iter_next (GmDeviceIter *iter, const char **name)
+{
+  GmRealDeviceIter *ri = (GmRealDeviceIter *)iter;
 
-  if (!children) {
-    g_critical ("Failed to enumerate known devices: %s", err->message);
-    return NULL;
-  }
+  g_return_val_if_fail (iter != NULL, FALSE);
 
-  for (int i = 0; children[i]; i++) {
-    if (!g_str_has_suffix (children[i], ".json"))
-      continue;
+  if (ri->pos >= ri->end)
+    return FALSE;
 
-    g_strv_builder_take (builder, g_strndup (children[i], strlen (children[i]) - 5));
-  }
+  if (name)
+    *name = ri->names[ri->pos];
+  ri->pos++;
 
-  return g_strv_builder_end (builder);
+  return TRUE;
 }
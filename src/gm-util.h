@@ -17,4 +17,23 @@
 #define gm_strv_is_null_or_empty(x) \
   ((x) == NULL || (x)[0] == NULL)
 
-GStrv gm_list_devices (void);
+/**
+ * GmDeviceIter:
+ *
+ * An opaque structure used to iterate over the known devices. It's
+ * usually allocated on the stack and initialized with
+ * [method@DeviceIter.init].
+ *
+ * Since: 0.8.0
+ */
+typedef struct _GmDeviceIter {
+  /*< private >*/
+  gpointer dummy1;
+  guint    dummy2;
+  guint    dummy3;
+  gpointer dummy4;
+} GmDeviceIter;
+
+GStrv    gm_list_devices     (void);
+void     gm_device_iter_init (GmDeviceIter *iter, const char *prefix);
+gboolean gm_device_iter_next (GmDeviceIter *iter, const char **name);
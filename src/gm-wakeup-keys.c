@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "gm-device-tree.h"
+#include "gm-dmi.h"
+#include "gm-hwdb.h"
+#include "gm-wakeup-keys.h"
+
+#include <string.h>
+
+#define WAKEUP_KEY_PREFIX "GM_WAKEUP_KEY_"
+#define WAKEUP_KEY_DEFAULT WAKEUP_KEY_PREFIX "DEFAULT"
+#define N_WORDS ((GM_WAKEUP_KEYS_MAX + 32) / 32)
+
+/**
+ * GmWakeupKeys:
+ *
+ * The keys of an input device that should unblank the screen of an
+ * idle device as configured in gmobile's hwdb data (see
+ * `gmobile.udev(5)`).
+ *
+ * The hwdb properties are resolved once into a bitmap so checking a
+ * key event is a single bit test. By default all keys are wakeup
+ * keys, `GM_WAKEUP_KEY_DEFAULT=0` flips the default and
+ * `GM_WAKEUP_KEY_<keycode>` overrides it for individual keys.
+ *
+ * Since: 0.8.0
+ */
+struct _GmWakeupKeys {
+  gboolean default_wakeup;
+  guint32  bits[N_WORDS];
+};
+
+G_DEFINE_BOXED_TYPE (GmWakeupKeys, gm_wakeup_keys, gm_wakeup_keys_ref, gm_wakeup_keys_unref)
+
+
+static inline void
+set_key (GmWakeupKeys *self, guint keycode, gboolean wakeup)
+{
+  if (wakeup)
+    self->bits[keycode / 32] |= 1u << (keycode % 32);
+  else
+    self->bits[keycode / 32] &= ~(1u << (keycode % 32));
+}
+
+
+static gboolean
+parse_bool (const char *value)
+{
+  return g_strcmp0 (value, "0") != 0;
+}
+
+/**
+ * gm_wakeup_keys_new:
+ * @modaliases: (array zero-terminated=1): The hwdb lookup keys of the
+ *   input device, e.g. `gmobile:name:gpio-keys:dt:purism,librem5r4`
+ *
+ * Resolves the wakeup keys of an input device from gmobile's hwdb data.
+ * If several modaliases set the same property the later one wins like
+ * with consecutive hwdb imports in udev rules. See
+ * [func@hwdb_get_property] for the format of the keys.
+ *
+ * Returns:(transfer full): The wakeup keys
+ *
+ * Since: 0.8.0
+ */
+GmWakeupKeys *
+gm_wakeup_keys_new (const char * const *modaliases)
+{
+  g_autoptr (GHashTable) properties = NULL;
+  GmWakeupKeys *self;
+  GHashTableIter iter;
+  const char *name, *value;
+
+  g_return_val_if_fail (modaliases, NULL);
+
+  properties = g_hash_table_new (g_str_hash, g_str_equal);
+  for (guint i = 0; modaliases[i]; i++) {
+    g_autoptr (GHashTable) matched = gm_hwdb_get_properties (modaliases[i]);
+
+    g_hash_table_iter_init (&iter, matched);
+    while (g_hash_table_iter_next (&iter, (gpointer *)&name, (gpointer *)&value)) {
+      if (g_str_has_prefix (name, WAKEUP_KEY_PREFIX))
+        g_hash_table_insert (properties, (gpointer)name, (gpointer)value);
+    }
+  }
+
+  self = g_atomic_rc_box_new0 (GmWakeupKeys);
+  self->default_wakeup = parse_bool (g_hash_table_lookup (properties, WAKEUP_KEY_DEFAULT) ?: "1");
+  if (self->default_wakeup)
+    memset (self->bits, 0xff, sizeof (self->bits));
+
+  g_hash_table_iter_init (&iter, properties);
+  while (g_hash_table_iter_next (&iter, (gpointer *)&name, (gpointer *)&value)) {
+    guint64 keycode;
+
+    if (!g_ascii_string_to_unsigned (name + strlen (WAKEUP_KEY_PREFIX), 10,
+                                     0, GM_WAKEUP_KEYS_MAX, &keycode, NULL))
+      continue;
+
+    set_key (self, keycode, parse_bool (value));
+  }
+
+  return self;
+}
+
+/**
+ * gm_wakeup_keys_new_for_input:
+ * @name: The input device's name as in `/sys/class/input/inputX/name`
+ * @atkbd: Whether the device is an AT keyboard
+ * @sysfs_root:(nullable): Path where /sys is mounted. Defaults to `/sys` if %NULL is passed.
+ *
+ * Resolves the wakeup keys of an input device. The hwdb lookup keys are
+ * built from the device's name, the machine's DMI modalias and its
+ * first device tree compatible like gmobile's udev rules do, see
+ * [ctor@WakeupKeys.new].
+ *
+ * Returns:(transfer full): The wakeup keys
+ *
+ * Since: 0.8.0
+ */
+GmWakeupKeys *
+gm_wakeup_keys_new_for_input (const char *name, gboolean atkbd, const char *sysfs_root)
+{
+  g_autoptr (GStrvBuilder) builder = g_strv_builder_new ();
+  g_autoptr (GmDeviceTreeCompatibles) compatibles = NULL;
+  g_autofree char *dmi_modalias = NULL;
+  g_auto (GStrv) modaliases = NULL;
+
+  g_return_val_if_fail (name, NULL);
+
+  /* Same order as in 61-gmobile.rules */
+  dmi_modalias = gm_dmi_get_modalias (sysfs_root, NULL);
+  if (dmi_modalias && atkbd)
+    g_strv_builder_take (builder, g_strdup_printf ("gmobile:atkbd:%s", dmi_modalias));
+  if (dmi_modalias)
+    g_strv_builder_take (builder, g_strdup_printf ("gmobile:name:%s:%s", name, dmi_modalias));
+
+  compatibles = gm_device_tree_get_cached_compatibles (sysfs_root, NULL);
+  if (compatibles) {
+    guint n_compatibles;
+    const char * const *strv = gm_device_tree_compatibles_get_strv (compatibles, &n_compatibles);
+
+    if (n_compatibles)
+      g_strv_builder_take (builder, g_strdup_printf ("gmobile:name:%s:dt:%s", name, strv[0]));
+  }
+
+  modaliases = g_strv_builder_end (builder);
+  return gm_wakeup_keys_new ((const char * const *)modaliases);
+}
+
+/**
+ * gm_wakeup_keys_ref:
+ * @self: The wakeup keys
+ *
+ * Acquires a reference. This is thread safe.
+ *
+ * Returns:(transfer full): The wakeup keys
+ *
+ * Since: 0.8.0
+ */
+GmWakeupKeys *
+gm_wakeup_keys_ref (GmWakeupKeys *self)
+{
+  g_return_val_if_fail (self, NULL);
+
+  return g_atomic_rc_box_acquire (self);
+}
+
+/**
+ * gm_wakeup_keys_unref:
+ * @self: The wakeup keys
+ *
+ * Releases a reference. This is thread safe.
+ *
+ * Since: 0.8.0
+ */
+void
+gm_wakeup_keys_unref (GmWakeupKeys *self)
+{
+  g_return_if_fail (self);
+
+  g_atomic_rc_box_release (self);
+}
+
+/**
+ * gm_wakeup_keys_is_wakeup_key:
+ * @self: The wakeup keys
+ * @keycode: The linux event code of the key
+ *
+ * Checks whether a key should unblank the screen. Keycodes above
+ * [const@WAKEUP_KEYS_MAX] use the device's default.
+ *
+ * Returns: %TRUE if the key is a wakeup key
+ *
+ * Since: 0.8.0
+ */
+gboolean
+gm_wakeup_keys_is_wakeup_key (GmWakeupKeys *self, guint keycode)
+{
+  g_return_val_if_fail (self, TRUE);
+
+  if (G_UNLIKELY (keycode > GM_WAKEUP_KEYS_MAX))
+    return self->default_wakeup;
+
+  return !!(self->bits[keycode / 32] & (1u << (keycode % 32)));
+}
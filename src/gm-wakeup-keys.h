@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_GMOBILE_INSIDE) && !defined(GMOBILE_COMPILATION)
+#error "Only <gmobile.h> can be included directly."
+#endif
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GM_WAKEUP_KEYS_MAX:
+ *
+ * The highest keycode tracked by [struct@WakeupKeys], matches the
+ * kernel's `KEY_MAX`.
+ *
+ * Since: 0.8.0
+ */
+#define GM_WAKEUP_KEYS_MAX 0x2ff
+
+typedef struct _GmWakeupKeys GmWakeupKeys;
+
+#define GM_TYPE_WAKEUP_KEYS (gm_wakeup_keys_get_type ())
+
+GType         gm_wakeup_keys_get_type       (void) G_GNUC_CONST;
+GmWakeupKeys *gm_wakeup_keys_new            (const char * const *modaliases);
+GmWakeupKeys *gm_wakeup_keys_new_for_input  (const char         *name,
+                                             gboolean            atkbd,
+                                             const char         *sysfs_root);
+GmWakeupKeys *gm_wakeup_keys_ref            (GmWakeupKeys       *self);
+void          gm_wakeup_keys_unref          (GmWakeupKeys       *self);
+gboolean      gm_wakeup_keys_is_wakeup_key  (GmWakeupKeys       *self,
+                                             guint               keycode);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (GmWakeupKeys, gm_wakeup_keys_unref)
+
+G_END_DECLS
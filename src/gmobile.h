@@ -20,8 +20,14 @@
 #include "gm-device-info.h"
 #include "gm-device-tree.h"
 #include "gm-display-panel.h"
+#include "gm-display-panel-snapshot.h"
+#include "gm-dmi.h"
 #include "gm-error.h"
+#include "gm-hwdb.h"
 #include "gm-main.h"
 #include "gm-mcc-mnc.h"
+#include "gm-operator-db.h"
+#include "gm-stats.h"
 #include "gm-timeout.h"
 #include "gm-util.h"
+#include "gm-wakeup-keys.h"
@@ -0,0 +1,334 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3-or-later
+ */
+
+#define GMOBILE_USE_UNSTABLE_API
+#include "gmobile.h"
+
+#include "gio/gio.h"
+
+#ifdef GM_HAVE_DEVICE_DB
+#define N_THREADS    8
+#define N_ITERATIONS 50
+
+typedef struct {
+  GmDeviceInfo   *info;
+  int            *start;
+  GmDisplayPanel *panel;
+} PanelThreadData;
+#endif
+
+
+static void
+on_async_done (GObject *source_object, GAsyncResult *res, gpointer user_data)
+{
+  GAsyncResult **result = user_data;
+
+  *result = g_object_ref (res);
+}
+
+
+static GAsyncResult *
+wait_for_result (GAsyncResult **result)
+{
+  while (*result == NULL)
+    g_main_context_iteration (NULL, TRUE);
+
+  return *result;
+}
+
+
+#ifdef GM_HAVE_DEVICE_DB
+static void
+test_gm_device_info_get_display_panel (void)
+{
+  const char *const compatibles[] = { "doesnotexist", "purism,librem5", NULL };
+  const char *const unknown[] = { "doesnotexist", NULL };
+  g_autoptr (GmDeviceInfo) info = NULL;
+  GmDisplayPanel *panel;
+
+  info = gm_device_info_new (compatibles);
+  panel = gm_device_info_get_display_panel (info);
+  g_assert_true (GM_IS_DISPLAY_PANEL (panel));
+  g_assert_cmpint (gm_display_panel_get_x_res (panel), ==, 720);
+  /* Cached */
+  g_assert_true (gm_device_info_get_display_panel (info) == panel);
+  g_clear_object (&info);
+
+  info = gm_device_info_new (unknown);
+  g_assert_null (gm_device_info_get_display_panel (info));
+}
+
+
+static void
+test_gm_device_info_lookup_panel_geometries (void)
+{
+  const char *const compatibles[] = { "purism,librem5", "doesnotexist", "pine64,pinephone-1.1",
+                                      NULL };
+  g_auto (GStrv) devices = gm_list_devices ();
+  g_autoptr (GVariant) geometries = NULL;
+  g_autoptr (GVariant) geometry = NULL;
+  const char *name;
+  int x_res;
+
+  geometries = gm_device_info_lookup_panel_geometries (compatibles);
+  g_assert_false (g_variant_is_floating (geometries));
+  g_assert_cmpstr (g_variant_get_type_string (geometries), ==,
+                   "a{s" GM_DISPLAY_PANEL_GEOMETRY_FORMAT "}");
+  g_assert_cmpuint (g_variant_n_children (geometries), ==, 2);
+
+  geometry = g_variant_lookup_value (geometries, "purism,librem5", NULL);
+  g_assert_nonnull (geometry);
+  g_variant_get (geometry, "(&siiii(iiii)a(s(iiii)s))", &name, &x_res, NULL, NULL, NULL,
+                 NULL, NULL, NULL, NULL, NULL);
+  g_assert_cmpstr (name, ==, "Purism Librem 5");
+  g_assert_cmpint (x_res, ==, 720);
+  g_clear_pointer (&geometry, g_variant_unref);
+
+  /* Patterns match too */
+  geometry = g_variant_lookup_value (geometries, "pine64,pinephone-1.1", NULL);
+  g_assert_nonnull (geometry);
+  g_clear_pointer (&geometry, g_variant_unref);
+
+  g_assert_null (g_variant_lookup_value (geometries, "doesnotexist", NULL));
+  g_clear_pointer (&geometries, g_variant_unref);
+
+  /* Every device in the database has a panel */
+  geometries = gm_device_info_lookup_panel_geometries ((const char * const *)devices);
+  g_assert_cmpuint (g_variant_n_children (geometries), ==, g_strv_length (devices));
+}
+
+
+static gpointer
+get_display_panel_thread (gpointer user_data)
+{
+  PanelThreadData *data = user_data;
+
+  /* Start all threads at once to maximize contention */
+  while (!g_atomic_int_get (data->start))
+    g_thread_yield ();
+
+  data->panel = gm_device_info_get_display_panel (data->info);
+
+  return NULL;
+}
+
+
+static void
+test_gm_device_info_concurrent (void)
+{
+  const char *const compatibles[] = { "doesnotexist", "purism,librem5", NULL };
+
+  for (int i = 0; i < N_ITERATIONS; i++) {
+    g_autoptr (GmDeviceInfo) info = gm_device_info_new (compatibles);
+    PanelThreadData data[N_THREADS];
+    GThread *threads[N_THREADS];
+    GmStats before, stats;
+    int start = FALSE;
+
+    gm_stats_get (&before);
+
+    for (int j = 0; j < N_THREADS; j++) {
+      data[j] = (PanelThreadData) { .info = info, .start = &start };
+      threads[j] = g_thread_new ("panel", get_display_panel_thread, &data[j]);
+    }
+    g_atomic_int_set (&start, TRUE);
+    for (int j = 0; j < N_THREADS; j++)
+      g_thread_join (threads[j]);
+
+    g_assert_true (GM_IS_DISPLAY_PANEL (data[0].panel));
+    for (int j = 1; j < N_THREADS; j++)
+      g_assert_true (data[j].panel == data[0].panel);
+    g_assert_true (gm_device_info_get_display_panel (info) == data[0].panel);
+
+    /* The panel was only built once */
+    gm_stats_get (&stats);
+    g_assert_cmpuint (stats.n_display_panels, ==, before.n_display_panels + 1);
+  }
+}
+
+
+static void
+test_gm_device_info_patterns (void)
+{
+  const char *const compatibles[] = { "pine64,pinephone-1.1", "allwinner,sun50i-a64", NULL };
+  const char *const no_match[] = { "pine64,pinephone-", "pine64,pinephone-2.0", NULL };
+  g_autoptr (GmDeviceInfo) info = NULL;
+  GmDisplayPanel *panel;
+
+  info = gm_device_info_new (compatibles);
+  panel = gm_device_info_get_display_panel (info);
+  g_assert_true (GM_IS_DISPLAY_PANEL (panel));
+  g_assert_cmpstr (gm_display_panel_get_name (panel), ==, "Pine64 PinePhone");
+  g_assert_cmpint (gm_display_panel_get_x_res (panel), ==, 720);
+  g_assert_cmpint (gm_display_panel_get_y_res (panel), ==, 1440);
+  g_clear_object (&info);
+
+  info = gm_device_info_new (no_match);
+  g_assert_null (gm_device_info_get_display_panel (info));
+}
+#endif
+
+
+static void
+test_gm_device_info_new_async (void)
+{
+  g_autoptr (GAsyncResult) result = NULL;
+  g_autoptr (GmDeviceInfo) info = NULL;
+  g_autoptr (GError) err = NULL;
+  g_auto (GStrv) compatibles = NULL;
+
+  gm_device_info_new_async (TEST_DATA_DIR "/compatibles1", NULL, on_async_done, &result);
+  info = gm_device_info_new_finish (wait_for_result (&result), &err);
+  g_assert_no_error (err);
+  g_assert_true (GM_IS_DEVICE_INFO (info));
+
+  g_object_get (info, "compatibles", &compatibles, NULL);
+  g_assert_cmpint (g_strv_length (compatibles), ==, 3);
+  g_assert_cmpstr (compatibles[0], ==, "purism,librem5r4");
+  g_assert_cmpstr (compatibles[1], ==, "purism,librem5");
+  g_assert_cmpstr (compatibles[2], ==, "fsl,imx8mq");
+  g_clear_object (&result);
+  g_clear_object (&info);
+
+  /* DMI data */
+  gm_device_info_new_async (TEST_DATA_DIR "/dmi1", NULL, on_async_done, &result);
+  info = gm_device_info_new_finish (wait_for_result (&result), &err);
+  g_assert_no_error (err);
+  g_clear_pointer (&compatibles, g_strfreev);
+  g_object_get (info, "compatibles", &compatibles, NULL);
+  g_assert_cmpstrv (compatibles, ((const char *[]){ "purism,librem5", NULL }));
+#ifdef GM_HAVE_DEVICE_DB
+  g_assert_true (GM_IS_DISPLAY_PANEL (gm_device_info_get_display_panel (info)));
+#endif
+  g_clear_object (&result);
+  g_clear_object (&info);
+
+  /* nonexistent */
+  gm_device_info_new_async (TEST_DATA_DIR "/doesnotexist", NULL, on_async_done, &result);
+  info = gm_device_info_new_finish (wait_for_result (&result), &err);
+  g_assert_error (err, G_IO_ERROR, G_IO_ERROR_NOT_FOUND);
+  g_assert_null (info);
+}
+
+
+static void
+test_gm_device_info_get_display_panel_async (void)
+{
+  const char *const unknown[] = { "doesnotexist", NULL };
+  g_autoptr (GAsyncResult) result = NULL;
+  g_autoptr (GmDeviceInfo) info = NULL;
+  g_autoptr (GError) err = NULL;
+  GmDisplayPanel *panel;
+
+#ifdef GM_HAVE_DEVICE_DB
+  gm_device_info_new_async (TEST_DATA_DIR "/compatibles1", NULL, on_async_done, &result);
+  info = gm_device_info_new_finish (wait_for_result (&result), &err);
+  g_assert_no_error (err);
+  g_clear_object (&result);
+
+  gm_device_info_get_display_panel_async (info, NULL, on_async_done, &result);
+  panel = gm_device_info_get_display_panel_finish (info, wait_for_result (&result), &err);
+  g_assert_no_error (err);
+  g_assert_true (GM_IS_DISPLAY_PANEL (panel));
+  g_assert_cmpstr (gm_display_panel_get_name (panel), ==, "Purism Librem 5");
+  /* The sync and async variants share the cached panel */
+  g_assert_true (gm_device_info_get_display_panel (info) == panel);
+  g_clear_object (&result);
+
+  /* Already cached */
+  gm_device_info_get_display_panel_async (info, NULL, on_async_done, &result);
+  g_assert_true (gm_device_info_get_display_panel_finish (info,
+                                                          wait_for_result (&result),
+                                                          &err) == panel);
+  g_assert_no_error (err);
+  g_clear_object (&result);
+  g_clear_object (&info);
+#endif
+
+  /* No matching panel */
+  info = gm_device_info_new (unknown);
+  gm_device_info_get_display_panel_async (info, NULL, on_async_done, &result);
+  panel = gm_device_info_get_display_panel_finish (info, wait_for_result (&result), &err);
+  g_assert_error (err, G_IO_ERROR, G_IO_ERROR_NOT_FOUND);
+  g_assert_null (panel);
+}
+
+
+static void
+test_gm_device_info_drm_fallback (void)
+{
+  const char *const unknown[] = { "doesnotexist", NULL };
+  g_autoptr (GmDeviceInfo) info = NULL;
+  GmDisplayPanel *panel;
+
+  /* DSI panel without EDID, external monitor is ignored */
+  info = g_object_new (GM_TYPE_DEVICE_INFO,
+                       "compatibles", unknown,
+                       "sysfs-root", TEST_DATA_DIR "/drm1",
+                       NULL);
+  panel = gm_device_info_get_display_panel (info);
+  g_assert_true (GM_IS_DISPLAY_PANEL (panel));
+  g_assert_cmpstr (gm_display_panel_get_name (panel), ==, "card0-DSI-1");
+  g_assert_cmpint (gm_display_panel_get_x_res (panel), ==, 720);
+  g_assert_cmpint (gm_display_panel_get_y_res (panel), ==, 1440);
+  g_assert_cmpint (gm_display_panel_get_width (panel), ==, 0);
+  g_assert_cmpint (gm_display_panel_get_height (panel), ==, 0);
+  g_clear_object (&info);
+
+  /* eDP panel with EDID, disconnected DSI is ignored */
+  for (int i = 0; i < 2; i++) {
+    info = g_object_new (GM_TYPE_DEVICE_INFO,
+                         "compatibles", unknown,
+                         "sysfs-root", TEST_DATA_DIR "/drm2",
+                         NULL);
+    panel = gm_device_info_get_display_panel (info);
+    g_assert_true (GM_IS_DISPLAY_PANEL (panel));
+    g_assert_cmpstr (gm_display_panel_get_name (panel), ==, "TESTPANEL");
+    g_assert_cmpint (gm_display_panel_get_x_res (panel), ==, 1920);
+    g_assert_cmpint (gm_display_panel_get_y_res (panel), ==, 1080);
+    g_assert_cmpint (gm_display_panel_get_width (panel), ==, 344);
+    g_assert_cmpint (gm_display_panel_get_height (panel), ==, 194);
+    g_clear_object (&info);
+  }
+
+#ifdef GM_HAVE_DEVICE_DB
+  /* The panel database wins */
+  info = g_object_new (GM_TYPE_DEVICE_INFO,
+                       "compatibles", (const char *const []){ "purism,librem5", NULL },
+                       "sysfs-root", TEST_DATA_DIR "/drm2",
+                       NULL);
+  panel = gm_device_info_get_display_panel (info);
+  g_assert_cmpstr (gm_display_panel_get_name (panel), ==, "Purism Librem 5");
+  g_clear_object (&info);
+#endif
+
+  /* No fallback without sysfs root */
+  info = gm_device_info_new (unknown);
+  g_assert_null (gm_device_info_get_display_panel (info));
+}
+
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  gm_init ();
+
+#ifdef GM_HAVE_DEVICE_DB
+  g_test_add_func ("/Gm/device-info/get_display_panel", test_gm_device_info_get_display_panel);
+  g_test_add_func ("/Gm/device-info/patterns", test_gm_device_info_patterns);
+  g_test_add_func ("/Gm/device-info/concurrent", test_gm_device_info_concurrent);
+  g_test_add_func ("/Gm/device-info/lookup_panel_geometries",
+                   test_gm_device_info_lookup_panel_geometries);
+#endif
+  g_test_add_func ("/Gm/device-info/new_async", test_gm_device_info_new_async);
+  g_test_add_func ("/Gm/device-info/get_display_panel_async",
+                   test_gm_device_info_get_display_panel_async);
+  g_test_add_func ("/Gm/device-info/drm_fallback", test_gm_device_info_drm_fallback);
+
+  return g_test_run ();
+}
@@ -44,12 +44,199 @@ test_gm_device_tree_get_compatibles (void)
 }
 
 
+static void
+test_gm_device_tree_get_cached_compatibles (void)
+{
+  g_autoptr (GmDeviceTreeCompatibles) compatibles = NULL;
+  g_autoptr (GmDeviceTreeCompatibles) compatibles2 = NULL;
+  const char * const *strv;
+  GError *err = NULL;
+  guint n;
+
+  compatibles = gm_device_tree_get_cached_compatibles (TEST_DATA_DIR "/compatibles1", &err);
+  g_assert_no_error (err);
+  g_assert_nonnull (compatibles);
+  strv = gm_device_tree_compatibles_get_strv (compatibles, &n);
+  g_assert_cmpint (n, ==, 3);
+  g_assert_cmpstr (strv[0], ==, "purism,librem5r4");
+  g_assert_cmpstr (strv[1], ==, "purism,librem5");
+  g_assert_cmpstr (strv[2], ==, "fsl,imx8mq");
+  g_assert_null (strv[3]);
+
+  /* Cached */
+  compatibles2 = gm_device_tree_get_cached_compatibles (TEST_DATA_DIR "/compatibles1", &err);
+  g_assert_no_error (err);
+  g_assert_true (compatibles == compatibles2);
+  g_clear_pointer (&compatibles2, gm_device_tree_compatibles_unref);
+
+  /* Invalidated */
+  gm_device_tree_invalidate_compatibles (TEST_DATA_DIR "/compatibles1");
+  compatibles2 = gm_device_tree_get_cached_compatibles (TEST_DATA_DIR "/compatibles1", &err);
+  g_assert_no_error (err);
+  g_assert_false (compatibles == compatibles2);
+  g_assert_cmpstrv (gm_device_tree_compatibles_get_strv (compatibles2, NULL), strv);
+  g_clear_pointer (&compatibles2, gm_device_tree_compatibles_unref);
+  g_clear_pointer (&compatibles, gm_device_tree_compatibles_unref);
+
+  /* empty file */
+  compatibles = gm_device_tree_get_cached_compatibles (TEST_DATA_DIR "/compatibles2", &err);
+  g_assert_no_error (err);
+  g_assert_nonnull (compatibles);
+  g_clear_pointer (&compatibles, gm_device_tree_compatibles_unref);
+
+  /* nonexistent, error is cached too */
+  for (int i = 0; i < 2; i++) {
+    compatibles = gm_device_tree_get_cached_compatibles (TEST_DATA_DIR "/doesnotexist", &err);
+    g_assert_null (compatibles);
+    g_assert_error (err, G_IO_ERROR, G_IO_ERROR_NOT_FOUND);
+    g_clear_error (&err);
+  }
+
+  /* Environment overrides aren't cached */
+  g_setenv ("GMOBILE_DT_COMPATIBLES", "foo,bar:baz,boing", TRUE);
+  compatibles = gm_device_tree_get_cached_compatibles (TEST_DATA_DIR "/compatibles1", &err);
+  g_assert_no_error (err);
+  strv = gm_device_tree_compatibles_get_strv (compatibles, &n);
+  g_assert_cmpint (n, ==, 2);
+  g_assert_cmpstr (strv[0], ==, "foo,bar");
+  g_assert_cmpstr (strv[1], ==, "baz,boing");
+  g_assert_null (strv[2]);
+  g_clear_pointer (&compatibles, gm_device_tree_compatibles_unref);
+  g_unsetenv ("GMOBILE_DT_COMPATIBLES");
+
+  compatibles = gm_device_tree_get_cached_compatibles (TEST_DATA_DIR "/compatibles1", &err);
+  g_assert_no_error (err);
+  strv = gm_device_tree_compatibles_get_strv (compatibles, &n);
+  g_assert_cmpint (n, ==, 3);
+  g_assert_cmpstr (strv[0], ==, "purism,librem5r4");
+}
+
+
+static void
+test_gm_device_tree_read_properties (void)
+{
+  GmDeviceTreeProperty props[] = {
+    { .name = "compatible", .type = GM_DEVICE_TREE_PROPERTY_STRINGS },
+    { .name = "width-mm", .type = GM_DEVICE_TREE_PROPERTY_U32_ARRAY },
+    { .name = "height-mm", .type = GM_DEVICE_TREE_PROPERTY_U32_ARRAY },
+    { .name = "reg", .type = GM_DEVICE_TREE_PROPERTY_U32_ARRAY },
+    { .name = "enable-active-high", .type = GM_DEVICE_TREE_PROPERTY_BOOLEAN },
+    { .name = "doesnotexist", .type = GM_DEVICE_TREE_PROPERTY_BOOLEAN },
+    { .name = "doesnotexist", .type = GM_DEVICE_TREE_PROPERTY_STRINGS },
+  };
+  GmDeviceTreeProperty broken[] = {
+    { .name = "compatible", .type = GM_DEVICE_TREE_PROPERTY_STRINGS },
+    { .name = "broken", .type = GM_DEVICE_TREE_PROPERTY_U32_ARRAY },
+  };
+  GError *err = NULL;
+  gboolean success;
+
+  success = gm_device_tree_read_properties (TEST_DATA_DIR "/properties1", "/panel",
+                                            props, G_N_ELEMENTS (props), &err);
+  g_assert_no_error (err);
+  g_assert_true (success);
+
+  g_assert_true (props[0].found);
+  g_assert_cmpstrv (props[0].strings, ((const char *[]){ "himax,hx8394", NULL }));
+  g_assert_true (props[1].found);
+  g_assert_cmpint (props[1].n_values, ==, 1);
+  g_assert_cmpint (props[1].values[0], ==, 65);
+  g_assert_true (props[2].found);
+  g_assert_cmpint (props[2].n_values, ==, 1);
+  g_assert_cmpint (props[2].values[0], ==, 130);
+  g_assert_true (props[3].found);
+  g_assert_cmpint (props[3].n_values, ==, 2);
+  g_assert_cmpint (props[3].values[0], ==, 0);
+  g_assert_cmpint (props[3].values[1], ==, 0x1000);
+  g_assert_true (props[4].found);
+  g_assert_false (props[5].found);
+  g_assert_false (props[6].found);
+  g_assert_null (props[6].strings);
+
+  for (int i = 0; i < G_N_ELEMENTS (props); i++)
+    gm_device_tree_property_clear (&props[i]);
+
+  /* Invalid length for u32 cells */
+  success = gm_device_tree_read_properties (TEST_DATA_DIR "/properties1", "/panel",
+                                            broken, G_N_ELEMENTS (broken), &err);
+  g_assert_error (err, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+  g_assert_false (success);
+  g_assert_false (broken[0].found);
+  g_assert_null (broken[0].strings);
+  g_clear_error (&err);
+
+  /* nonexistent node */
+  success = gm_device_tree_read_properties (TEST_DATA_DIR "/properties1", "/doesnotexist",
+                                            props, G_N_ELEMENTS (props), &err);
+  g_assert_error (err, G_IO_ERROR, G_IO_ERROR_NOT_FOUND);
+  g_assert_false (success);
+  g_clear_error (&err);
+}
+
+
+static void
+test_gm_device_tree_read_single (void)
+{
+  g_auto (GStrv) strings = NULL;
+  g_autofree guint32 *values = NULL;
+  GError *err = NULL;
+  gsize n_values;
+
+  strings = gm_device_tree_read_strings (TEST_DATA_DIR "/properties1", "/", "model", &err);
+  g_assert_no_error (err);
+  g_assert_cmpstrv (strings, ((const char *[]){ "Purism Librem 5r4", NULL }));
+  g_clear_pointer (&strings, g_strfreev);
+
+  strings = gm_device_tree_read_strings (TEST_DATA_DIR "/properties1", "/", "doesnotexist", &err);
+  g_assert_error (err, G_IO_ERROR, G_IO_ERROR_NOT_FOUND);
+  g_assert_null (strings);
+  g_clear_error (&err);
+
+  values = gm_device_tree_read_u32_array (TEST_DATA_DIR "/properties1", "/panel", "width-mm",
+                                          &n_values, &err);
+  g_assert_no_error (err);
+  g_assert_cmpint (n_values, ==, 1);
+  g_assert_cmpint (values[0], ==, 65);
+  g_clear_pointer (&values, g_free);
+
+  values = gm_device_tree_read_u32_array (TEST_DATA_DIR "/properties1", "/panel", "broken",
+                                          &n_values, &err);
+  g_assert_error (err, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+  g_assert_null (values);
+  g_clear_error (&err);
+
+  g_assert_true (gm_device_tree_read_boolean (TEST_DATA_DIR "/properties1", "/panel",
+                                              "enable-active-high"));
+  g_assert_false (gm_device_tree_read_boolean (TEST_DATA_DIR "/properties1", "/panel",
+                                               "doesnotexist"));
+  g_assert_false (gm_device_tree_read_boolean (TEST_DATA_DIR "/properties1", "/doesnotexist",
+                                               "doesnotexist"));
+
+  /* The override applies to the root node's compatible only */
+  g_setenv ("GMOBILE_DT_COMPATIBLES", "foo,bar:baz,boing", TRUE);
+  strings = gm_device_tree_read_strings (TEST_DATA_DIR "/doesnotexist", "/", "compatible", &err);
+  g_assert_no_error (err);
+  g_assert_cmpstrv (strings, ((const char *[]){ "foo,bar", "baz,boing", NULL }));
+  g_clear_pointer (&strings, g_strfreev);
+
+  strings = gm_device_tree_read_strings (TEST_DATA_DIR "/properties1", "/panel", "compatible",
+                                         &err);
+  g_assert_no_error (err);
+  g_assert_cmpstrv (strings, ((const char *[]){ "himax,hx8394", NULL }));
+  g_unsetenv ("GMOBILE_DT_COMPATIBLES");
+}
+
+
 gint
 main (gint argc, gchar *argv[])
 {
   g_test_init (&argc, &argv, NULL);
 
   g_test_add_func ("/Gm/device-tree/get-compatibles", test_gm_device_tree_get_compatibles);
+  g_test_add_func ("/Gm/device-tree/get-cached-compatibles",
+                   test_gm_device_tree_get_cached_compatibles);
+  g_test_add_func ("/Gm/device-tree/read-properties", test_gm_device_tree_read_properties);
+  g_test_add_func ("/Gm/device-tree/read-single", test_gm_device_tree_read_single);
 
   return g_test_run ();
 }
@@ -9,7 +9,9 @@
 #define GMOBILE_USE_UNSTABLE_API
 #include "gmobile.h"
 
-#include <json-glib/json-glib.h>
+#ifdef GM_HAVE_JSON_GLIB
+# include <json-glib/json-glib.h>
+#endif
 
 static void
 test_gm_display_panel_parse (void)
@@ -117,12 +119,224 @@ G_GNUC_END_IGNORE_DEPRECATIONS
   g_assert_cmpint (gm_display_panel_get_width (panel), ==, 68);
   g_assert_cmpint (gm_display_panel_get_height (panel), ==, 145);
 
+#ifdef GM_HAVE_JSON_GLIB
   out = json_gobject_to_data (G_OBJECT (panel), NULL);
   g_assert_nonnull (out);
   g_test_message ("Out: %s", out);
+#endif
 }
 
 
+static void
+test_gm_display_panel_parse_errors (void)
+{
+  struct {
+    const char *json;
+    const char *msg;
+  } invalid[] = {
+    { "", "1:1: Unexpected end of data, expected '{'" },
+    { "{\n  \"x-res\": -1\n}", "2:12: 'x-res' must not be negative" },
+    { "{ \"y-res\": 1.5 }", "1:12: 'y-res' must be an integer" },
+    { "{ \"width\": 99999999999 }", "1:12: 'width' is too large" },
+    { "{ \"corner-radii\": [ 1, 2, 3 ] }", "1:19: 'corner-radii' needs exactly 4 elements" },
+    { "{ \"corner-radii\": [ 1, 2, 3, 4, 5 ] }",
+      "1:19: 'corner-radii' needs exactly 4 elements" },
+    { "{ \"name\": \"foo }", "1:11: Unterminated string" },
+    { "{ \"name\": \"foo\" \"x-res\": 1 }", "1:17: Expected ',' or '}'" },
+    { "{}\n  x", "2:3: Trailing data after panel description" },
+    { "{ \"cutouts\": [ { \"name\": \"notch\" } ] }", "1:16: Cutout lacks a 'path'" },
+    { "{\n \"cutouts\": [\n  { \"path\": \"M 1 2 X\" }\n ]\n}",
+      "3:13: Invalid cutout path: Unknown command 'X'" },
+  };
+
+  for (int i = 0; i < G_N_ELEMENTS (invalid); i++) {
+    g_autoptr (GError) err = NULL;
+    g_autoptr (GmDisplayPanel) panel = NULL;
+
+    panel = gm_display_panel_new_from_data (invalid[i].json, &err);
+    g_assert_null (panel);
+    g_assert_error (err, GM_ERROR, GM_ERROR_PARSING_FAILED);
+    g_assert_cmpstr (err->message, ==, invalid[i].msg);
+  }
+}
+
+
+static void
+test_gm_display_panel_parse_unknown_members (void)
+{
+  const char *json = "{"
+                     " \"name\": \"Unknown \\u00e4 members\","
+                     " \"vendor\": { \"a\": [ 1, -2.5e3, true, false, null ] },"
+                     " \"x-res\": 720,"
+                     " \"cutouts\": null"
+                     "}";
+  g_autoptr (GError) err = NULL;
+  g_autoptr (GmDisplayPanel) panel = NULL;
+
+  panel = gm_display_panel_new_from_data (json, &err);
+  g_assert_no_error (err);
+  g_assert_nonnull (panel);
+  g_assert_cmpstr (gm_display_panel_get_name (panel), ==, "Unknown \u00e4 members");
+  g_assert_cmpint (gm_display_panel_get_x_res (panel), ==, 720);
+  g_assert_cmpint (g_list_model_get_n_items (gm_display_panel_get_cutouts (panel)), ==, 0);
+}
+
+
+static void
+test_gm_display_panel_snapshot (void)
+{
+  const char *json = "{"
+                     " \"name\": \"Oneplus 6T\","
+                     " \"x-res\": 1080,"
+                     " \"y-res\": 2340,"
+                     " \"corner-radii\": [ 10, 11, 12, 13 ],"
+                     " \"width\": 68,"
+                     " \"height\": 145,"
+                     " \"cutouts\" : ["
+                     "   { \"name\": \"notch\", \"path\": \"M 455 0 V 79 H 625 V 0 Z\" }"
+                     " ]"
+                     "}";
+  g_autoptr (GError) err = NULL;
+  g_autoptr (GmDisplayPanel) panel = NULL;
+  g_autoptr (GmDisplayPanelSnapshot) snapshot = NULL;
+  g_autoptr (GmDisplayPanelSnapshot) snapshot2 = NULL;
+  g_autoptr (GmDisplayPanelSnapshot) snapshot3 = NULL;
+  g_autoptr (GmCutout) cutout = NULL;
+
+  panel = gm_display_panel_new_from_data (json, &err);
+  g_assert_no_error (err);
+  g_assert_nonnull (panel);
+
+  snapshot = gm_display_panel_get_snapshot (panel);
+  g_assert_nonnull (snapshot);
+  g_assert_cmpint (snapshot->x_res, ==, 1080);
+  g_assert_cmpint (snapshot->y_res, ==, 2340);
+  g_assert_cmpint (snapshot->width, ==, 68);
+  g_assert_cmpint (snapshot->height, ==, 145);
+  g_assert_cmpint (snapshot->corner_radii[GM_CORNER_POSITION_TOP_LEFT], ==, 10);
+  g_assert_cmpint (snapshot->corner_radii[GM_CORNER_POSITION_BOTTOM_LEFT], ==, 13);
+  g_assert_cmpint (snapshot->n_cutouts, ==, 1);
+  g_assert_cmpstr (snapshot->cutouts[0].name, ==, "notch");
+  g_assert_cmpstr (snapshot->cutouts[0].path, ==, "M 455 0 V 79 H 625 V 0 Z");
+  g_assert_cmpint (snapshot->cutouts[0].bounds.x, ==, 455);
+  g_assert_cmpint (snapshot->cutouts[0].bounds.width, ==, 170);
+  g_assert_cmpint (snapshot->cutouts[0].bounds.height, ==, 79);
+
+  /* Unchanged panel gives the same snapshot */
+  snapshot2 = gm_display_panel_get_snapshot (panel);
+  g_assert_true (snapshot == snapshot2);
+  g_clear_pointer (&snapshot2, gm_display_panel_snapshot_unref);
+
+  /* Changing properties or cutouts gives a new one, old one stays valid */
+  g_object_set (panel, "x-res", 720, NULL);
+  snapshot2 = gm_display_panel_get_snapshot (panel);
+  g_assert_false (snapshot == snapshot2);
+  g_assert_cmpint (snapshot2->x_res, ==, 720);
+  g_assert_cmpint (snapshot->x_res, ==, 1080);
+
+  cutout = gm_cutout_new ("M 0 0 V 10 H 10 V 0 Z");
+  g_list_store_append (G_LIST_STORE (gm_display_panel_get_cutouts (panel)), cutout);
+  snapshot3 = gm_display_panel_get_snapshot (panel);
+  g_assert_false (snapshot2 == snapshot3);
+  g_assert_cmpint (snapshot3->n_cutouts, ==, 2);
+  g_assert_null (snapshot3->cutouts[1].name);
+  g_assert_cmpint (snapshot3->cutouts[1].bounds.width, ==, 10);
+  g_assert_cmpint (snapshot2->n_cutouts, ==, 1);
+}
+
+
+static void
+test_gm_display_panel_geometry (void)
+{
+  const char *json = "{"
+                     " \"name\": \"Oneplus 6T\","
+                     " \"x-res\": 1080,"
+                     " \"y-res\": 2340,"
+                     " \"corner-radii\": [ 10, 11, 12, 13 ],"
+                     " \"width\": 68,"
+                     " \"height\": 145,"
+                     " \"cutouts\" : ["
+                     "   { \"name\": \"notch\", \"path\": \"M 455 0 V 79 H 625 V 0 Z\" }"
+                     " ]"
+                     "}";
+  g_autoptr (GError) err = NULL;
+  g_autoptr (GmDisplayPanel) panel = NULL;
+  g_autoptr (GVariant) geometry = NULL;
+  g_autoptr (GVariantIter) cutouts = NULL;
+  g_autoptr (GmCutout) cutout = NULL;
+  const char *name, *path;
+  int x_res, y_res, width, height, radii[4];
+  GmRect bounds;
+
+  panel = gm_display_panel_new_from_data (json, &err);
+  g_assert_no_error (err);
+  g_assert_nonnull (panel);
+
+  geometry = gm_display_panel_get_geometry (panel);
+  g_assert_false (g_variant_is_floating (geometry));
+  g_assert_cmpstr (g_variant_get_type_string (geometry), ==, GM_DISPLAY_PANEL_GEOMETRY_FORMAT);
+
+  g_variant_get (geometry, "(&siiii(iiii)a(s(iiii)s))", &name, &x_res, &y_res, &width, &height,
+                 &radii[0], &radii[1], &radii[2], &radii[3], &cutouts);
+  g_assert_cmpstr (name, ==, "Oneplus 6T");
+  g_assert_cmpint (x_res, ==, 1080);
+  g_assert_cmpint (y_res, ==, 2340);
+  g_assert_cmpint (width, ==, 68);
+  g_assert_cmpint (height, ==, 145);
+  g_assert_cmpint (radii[GM_CORNER_POSITION_TOP_LEFT], ==, 10);
+  g_assert_cmpint (radii[GM_CORNER_POSITION_BOTTOM_LEFT], ==, 13);
+
+  g_assert_cmpuint (g_variant_iter_n_children (cutouts), ==, 1);
+  g_assert_true (g_variant_iter_next (cutouts, "(&s(iiii)&s)", &name,
+                                      &bounds.x, &bounds.y, &bounds.width, &bounds.height,
+                                      &path));
+  g_assert_cmpstr (name, ==, "notch");
+  g_assert_cmpstr (path, ==, "M 455 0 V 79 H 625 V 0 Z");
+  g_assert_cmpint (bounds.x, ==, 455);
+  g_assert_cmpint (bounds.y, ==, 0);
+  g_assert_cmpint (bounds.width, ==, 170);
+  g_assert_cmpint (bounds.height, ==, 79);
+  g_clear_pointer (&cutouts, g_variant_iter_free);
+  g_clear_pointer (&geometry, g_variant_unref);
+
+  /* Unnamed cutouts get an empty name */
+  cutout = gm_cutout_new ("M 0 0 V 10 H 10 V 0 Z");
+  g_list_store_append (G_LIST_STORE (gm_display_panel_get_cutouts (panel)), cutout);
+  geometry = gm_display_panel_get_geometry (panel);
+  g_variant_get (geometry, "(&siiii(iiii)a(s(iiii)s))", NULL, NULL, NULL, NULL, NULL,
+                 NULL, NULL, NULL, NULL, &cutouts);
+  g_assert_cmpuint (g_variant_iter_n_children (cutouts), ==, 2);
+  g_assert_true (g_variant_iter_next (cutouts, "(&s(iiii)&s)", NULL, NULL, NULL, NULL, NULL, NULL));
+  g_assert_true (g_variant_iter_next (cutouts, "(&s(iiii)&s)", &name, NULL, NULL,
+                                      &bounds.width, NULL, NULL));
+  g_assert_cmpstr (name, ==, "");
+  g_assert_cmpint (bounds.width, ==, 10);
+}
+
+
+#ifdef GM_HAVE_DEVICE_DB
+static void
+test_gm_display_panel_all_devices (void)
+{
+  g_auto (GStrv) devices = gm_list_devices ();
+
+  g_assert_nonnull (devices);
+  for (int i = 0; devices[i]; i++) {
+    g_autoptr (GError) err = NULL;
+    g_autoptr (GmDisplayPanel) panel = NULL;
+    g_autofree char *resource = NULL;
+
+    resource = g_strdup_printf ("/mobi/phosh/gmobile/devices/display-panels/%s.json", devices[i]);
+    panel = gm_display_panel_new_from_resource (resource, &err);
+    g_assert_no_error (err);
+    g_assert_nonnull (panel);
+    g_assert_cmpint (gm_display_panel_get_x_res (panel), >, 0);
+    g_assert_cmpint (gm_display_panel_get_y_res (panel), >, 0);
+  }
+}
+#endif
+
+
 gint
 main (gint argc, gchar *argv[])
 {
@@ -130,6 +344,14 @@ main (gint argc, gchar *argv[])
 
   g_test_add_func ("/Gm/display-panel/parse", test_gm_display_panel_parse);
   g_test_add_func ("/Gm/display-panel/corner_radii", test_gm_display_panel_corner_radii);
+  g_test_add_func ("/Gm/display-panel/parse_errors", test_gm_display_panel_parse_errors);
+  g_test_add_func ("/Gm/display-panel/parse_unknown_members",
+                   test_gm_display_panel_parse_unknown_members);
+  g_test_add_func ("/Gm/display-panel/snapshot", test_gm_display_panel_snapshot);
+  g_test_add_func ("/Gm/display-panel/geometry", test_gm_display_panel_geometry);
+#ifdef GM_HAVE_DEVICE_DB
+  g_test_add_func ("/Gm/display-panel/all_devices", test_gm_display_panel_all_devices);
+#endif
 
   return g_test_run ();
 }
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3-or-later
+ */
+
+#define GMOBILE_USE_UNSTABLE_API
+#include "gmobile.h"
+
+#include "gio/gio.h"
+
+
+static void
+test_gm_dmi_to_compatible (void)
+{
+  struct {
+    const char *vendor;
+    const char *product;
+    const char *compatible;
+  } cases[] = {
+    { "Purism", "Librem5", "purism,librem5" },
+    { "GPD", "G1619-04", "gpd,g1619-04" },
+    { "  LENOVO ", "Yoga Tab 3-X90F", "lenovo,yoga-tab-3-x90f" },
+    { "Micro-Star International Co., Ltd.", "MS-7B86", "micro-star-international-co-ltd,ms-7b86" },
+    { "---", "foo", NULL },
+    { "foo", "", NULL },
+  };
+
+  for (int i = 0; i < G_N_ELEMENTS (cases); i++) {
+    g_autofree char *compatible = gm_dmi_to_compatible (cases[i].vendor, cases[i].product);
+
+    g_assert_cmpstr (compatible, ==, cases[i].compatible);
+  }
+}
+
+
+static void
+test_gm_dmi_get_compatible (void)
+{
+  g_autofree char *compatible = NULL;
+  GError *err = NULL;
+
+  compatible = gm_dmi_get_compatible (TEST_DATA_DIR "/dmi1", &err);
+  g_assert_no_error (err);
+  g_assert_cmpstr (compatible, ==, "purism,librem5");
+  g_clear_pointer (&compatible, g_free);
+
+  compatible = gm_dmi_get_compatible (TEST_DATA_DIR "/doesnotexist", &err);
+  g_assert_error (err, G_IO_ERROR, G_IO_ERROR_NOT_FOUND);
+  g_assert_null (compatible);
+  g_clear_error (&err);
+}
+
+
+static void
+test_gm_dmi_get_modalias (void)
+{
+  g_autofree char *modalias = NULL;
+  GError *err = NULL;
+
+  modalias = gm_dmi_get_modalias (TEST_DATA_DIR "/dmi1", &err);
+  g_assert_no_error (err);
+  g_assert_cmpstr (modalias, ==, "dmi:bvnPurism:bvr1.0:bd01/01/2024:svnPurism:pnLibrem5:pvr1.0:");
+  g_clear_pointer (&modalias, g_free);
+
+  modalias = gm_dmi_get_modalias (TEST_DATA_DIR "/doesnotexist", &err);
+  g_assert_error (err, G_IO_ERROR, G_IO_ERROR_NOT_FOUND);
+  g_assert_null (modalias);
+  g_clear_error (&err);
+}
+
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/Gm/dmi/to_compatible", test_gm_dmi_to_compatible);
+  g_test_add_func ("/Gm/dmi/get_compatible", test_gm_dmi_get_compatible);
+  g_test_add_func ("/Gm/dmi/get_modalias", test_gm_dmi_get_modalias);
+
+  return g_test_run ();
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3-or-later
+ */
+
+#define GMOBILE_USE_UNSTABLE_API
+#include "gmobile.h"
+
+#define LIBREM11_DMI "dmi:bvnAmericanMegatrendsInternational,LLC.:bvr1.0:bd01/01/2024:" \
+  "svnPurism:pnLibrem11:pvr1.0"
+
+
+static void
+test_gm_hwdb_get_property (void)
+{
+  /* Device tree match */
+  g_assert_cmpstr (gm_hwdb_get_property ("gmobile:name:gpio-keys:dt:purism,librem5r4",
+                                         "GM_WAKEUP_KEY_114"), ==, "0");
+  g_assert_cmpstr (gm_hwdb_get_property ("gmobile:name:gpio-keys:dt:purism,librem5r4",
+                                         "GM_WAKEUP_KEY_115"), ==, "0");
+  g_assert_null (gm_hwdb_get_property ("gmobile:name:gpio-keys:dt:purism,librem5r4",
+                                       "GM_WAKEUP_KEY_116"));
+  g_assert_null (gm_hwdb_get_property ("gmobile:name:gpio-keys:dt:pine64,pinephone-1.2",
+                                       "GM_WAKEUP_KEY_114"));
+
+  /* Glob in the middle of a pattern */
+  g_assert_cmpstr (gm_hwdb_get_property ("gmobile:name:1c21800.lradc:dt:pine64,pinephone-1.2",
+                                         "GM_WAKEUP_KEY_DEFAULT"), ==, "0");
+  g_assert_cmpstr (gm_hwdb_get_property ("gmobile:name:WH-1000XM4 (AVRCP) _AVRCP_:dt:foo",
+                                         "GM_WAKEUP_KEY_DEFAULT"), ==, "0");
+
+  /* DMI match */
+  g_assert_cmpstr (gm_hwdb_get_property ("gmobile:atkbd:" LIBREM11_DMI, "GM_WAKEUP_KEY_114"),
+                   ==, "0");
+  g_assert_null (gm_hwdb_get_property ("gmobile:name:gpio-keys:" LIBREM11_DMI,
+                                       "GM_WAKEUP_KEY_114"));
+
+  /* Torch */
+  g_assert_cmpstr (gm_hwdb_get_property ("gmobile:name:white:flash:dt:purism,librem5",
+                                         "GM_TORCH_MIN_BRIGHTNESS"), ==, "1");
+
+  g_assert_null (gm_hwdb_get_property ("", "GM_TORCH_MIN_BRIGHTNESS"));
+  g_assert_null (gm_hwdb_get_property ("gmobile:name:", "GM_TORCH_MIN_BRIGHTNESS"));
+}
+
+
+static void
+test_gm_hwdb_get_properties (void)
+{
+  g_autoptr (GHashTable) props = NULL;
+
+  props = gm_hwdb_get_properties ("gmobile:name:mtk-kpd:dt:furilabs,flx1");
+  g_assert_cmpint (g_hash_table_size (props), ==, 3);
+  g_assert_cmpstr (g_hash_table_lookup (props, "GM_WAKEUP_KEY_112"), ==, "0");
+  g_assert_cmpstr (g_hash_table_lookup (props, "GM_WAKEUP_KEY_114"), ==, "0");
+  g_assert_cmpstr (g_hash_table_lookup (props, "GM_WAKEUP_KEY_115"), ==, "0");
+  g_clear_pointer (&props, g_hash_table_unref);
+
+  props = gm_hwdb_get_properties ("gmobile:name:mtk-kpd:dt:furilabs");
+  g_assert_cmpint (g_hash_table_size (props), ==, 0);
+}
+
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/Gm/hwdb/get_property", test_gm_hwdb_get_property);
+  g_test_add_func ("/Gm/hwdb/get_properties", test_gm_hwdb_get_properties);
+
+  return g_test_run ();
+}
@@ -37,12 +37,127 @@ test_country_code (void)
 }
 
 
+static void
+test_country_code_no_alloc (void)
+{
+  const char imsi[] = { '2', '2', '8', '0', '1' };
+
+  g_assert_cmpstr (gm_mcc_num_to_iso (228), ==, "CH");
+  g_assert_cmpstr (gm_mcc_num_to_iso (750), ==, "FK");
+  g_assert_null (gm_mcc_num_to_iso (0));
+  g_assert_null (gm_mcc_num_to_iso (999));
+  g_assert_null (gm_mcc_num_to_iso (1000));
+  g_assert_null (gm_mcc_num_to_iso (G_MAXUINT));
+
+  /* Not NUL terminated */
+  g_assert_cmpstr (gm_mcc_str_to_iso (imsi, sizeof (imsi)), ==, "CH");
+  g_assert_cmpstr (gm_mcc_str_to_iso (imsi, 3), ==, "CH");
+  g_assert_null (gm_mcc_str_to_iso (imsi, 2));
+
+  g_assert_cmpstr (gm_mcc_str_to_iso ("228", -1), ==, "CH");
+  g_assert_cmpstr (gm_mcc_str_to_iso ("310150123456789", -1), ==, "US");
+  g_assert_null (gm_mcc_str_to_iso ("22", -1));
+  g_assert_null (gm_mcc_str_to_iso ("", -1));
+  g_assert_null (gm_mcc_str_to_iso (NULL, -1));
+  g_assert_null (gm_mcc_str_to_iso ("2a8", -1));
+  g_assert_null (gm_mcc_str_to_iso (" 28", -1));
+  g_assert_null (gm_mcc_str_to_iso ("999", -1));
+
+  /* Shared MCC, the first listed country wins */
+  g_assert_cmpstr (gm_mcc_str_to_iso ("340", -1), ==, "GP");
+}
+
+
+static void
+test_country_codes (void)
+{
+  const char * const *isos;
+
+  isos = gm_mcc_num_to_isos (340);
+  g_assert_cmpstrv (isos, ((const char *[]){ "GP", "MQ", NULL }));
+  g_assert_true (gm_mcc_num_to_isos (340) == isos);
+
+  isos = gm_mcc_str_to_isos ("34001", -1);
+  g_assert_cmpstrv (isos, ((const char *[]){ "GP", "MQ", NULL }));
+
+  isos = gm_mcc_str_to_isos ("228", 3);
+  g_assert_cmpstrv (isos, ((const char *[]){ "CH", NULL }));
+
+  g_assert_null (gm_mcc_num_to_isos (0));
+  g_assert_null (gm_mcc_num_to_isos (1000));
+  g_assert_null (gm_mcc_str_to_isos ("22", -1));
+  g_assert_null (gm_mcc_str_to_isos ("abc", -1));
+}
+
+
+static void
+test_mccs (void)
+{
+  const guint16 *mccs;
+  guint n_mccs;
+
+  mccs = gm_mcc_iso_to_mccs ("CH", &n_mccs);
+  g_assert_cmpuint (n_mccs, ==, 1);
+  g_assert_cmpuint (mccs[0], ==, 228);
+
+  mccs = gm_mcc_iso_to_mccs ("us", &n_mccs);
+  g_assert_cmpuint (n_mccs, >, 1);
+  g_assert_cmpuint (mccs[0], ==, 310);
+  for (guint i = 0; i < n_mccs; i++)
+    g_assert_cmpstr (gm_mcc_num_to_iso (mccs[i]), ==, "US");
+
+  /* Shared MCC */
+  mccs = gm_mcc_iso_to_mccs ("MQ", &n_mccs);
+  g_assert_cmpuint (n_mccs, ==, 1);
+  g_assert_cmpuint (mccs[0], ==, 340);
+
+  g_assert_null (gm_mcc_iso_to_mccs ("XX", &n_mccs));
+  g_assert_cmpuint (n_mccs, ==, 0);
+  g_assert_null (gm_mcc_iso_to_mccs ("C", &n_mccs));
+  g_assert_null (gm_mcc_iso_to_mccs ("CHE", &n_mccs));
+  g_assert_null (gm_mcc_iso_to_mccs ("1H", &n_mccs));
+  g_assert_null (gm_mcc_iso_to_mccs (NULL, &n_mccs));
+}
+
+
+static void
+test_classify (void)
+{
+  const char *strs[] = { "228011234567890", "310150", "abc", NULL, "22", "999", "34001", "228" };
+  guint16 indices[G_N_ELEMENTS (strs)];
+  guint n_found;
+
+  g_assert_cmpuint (gm_mcc_get_n_countries (), >, 200);
+  g_assert_null (gm_mcc_country_index_to_iso (0));
+  g_assert_nonnull (gm_mcc_country_index_to_iso (gm_mcc_get_n_countries ()));
+  g_assert_null (gm_mcc_country_index_to_iso (gm_mcc_get_n_countries () + 1));
+
+  n_found = gm_mcc_classify (strs, G_N_ELEMENTS (strs), indices);
+  g_assert_cmpuint (n_found, ==, 4);
+
+  g_assert_cmpstr (gm_mcc_country_index_to_iso (indices[0]), ==, "CH");
+  g_assert_cmpstr (gm_mcc_country_index_to_iso (indices[1]), ==, "US");
+  g_assert_cmpuint (indices[2], ==, 0);
+  g_assert_cmpuint (indices[3], ==, 0);
+  g_assert_cmpuint (indices[4], ==, 0);
+  g_assert_cmpuint (indices[5], ==, 0);
+  g_assert_cmpstr (gm_mcc_country_index_to_iso (indices[6]), ==, "GP");
+  g_assert_cmpuint (indices[7], ==, indices[0]);
+
+  g_assert_cmpuint (gm_mcc_classify (NULL, 0, NULL), ==, 0);
+}
+
+
 gint
 main (gint argc, gchar *argv[])
 {
   g_test_init (&argc, &argv, NULL);
 
   g_test_add_func ("/Gm/mcc-mnc/country-code", test_country_code);
+  g_test_add_func ("/Gm/mcc-mnc/country-code-no-alloc", test_country_code_no_alloc);
+  g_test_add_func ("/Gm/mcc-mnc/country-codes", test_country_codes);
+  g_test_add_func ("/Gm/mcc-mnc/mccs", test_mccs);
+  g_test_add_func ("/Gm/mcc-mnc/classify", test_classify);
 
   return g_test_run ();
 }
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3-or-later
+ */
+
+#define GMOBILE_USE_UNSTABLE_API
+#include "gmobile.h"
+
+#include "gio/gio.h"
+
+
+static void
+test_gm_operator_db_lookup (void)
+{
+  g_autoptr (GmOperatorDb) db = NULL;
+  GmOperatorInfo info;
+  GError *err = NULL;
+
+  db = gm_operator_db_new_for_path (TEST_OPERATOR_DB, &err);
+  g_assert_no_error (err);
+  g_assert_nonnull (db);
+  g_assert_cmpuint (gm_operator_db_get_n_operators (db), ==, 6);
+
+  /* Two digit MNC */
+  g_assert_true (gm_operator_db_lookup (db, "22802", -1, &info));
+  g_assert_cmpstr (info.name, ==, "Sunrise");
+  g_assert_cmpstr (info.country, ==, "CH");
+  g_assert_cmpuint (info.mcc, ==, 228);
+  g_assert_cmpuint (info.mnc, ==, 2);
+  g_assert_cmpuint (info.mnc_len, ==, 2);
+  g_assert_cmpint (info.flags, ==, GM_OPERATOR_FLAG_NONE);
+
+  /* Several operators on the same network */
+  g_assert_true (gm_operator_db_lookup (db, "22801", -1, &info));
+  g_assert_cmpstr (info.name, ==, "Swisscom");
+  g_assert_cmpint (info.flags, ==, GM_OPERATOR_FLAG_SHARED);
+
+  /* The primary operator wins */
+  g_assert_true (gm_operator_db_lookup (db, "310410", -1, &info));
+  g_assert_cmpstr (info.name, ==, "AT&T");
+  g_assert_cmpstr (info.country, ==, "US");
+  g_assert_cmpuint (info.mnc, ==, 410);
+  g_assert_cmpuint (info.mnc_len, ==, 3);
+  g_assert_cmpint (info.flags, ==, GM_OPERATOR_FLAG_SHARED);
+
+  /* Three digit MNC from an IMSI */
+  g_assert_true (gm_operator_db_lookup (db, "310260123456789", -1, &info));
+  g_assert_cmpstr (info.name, ==, "T-Mobile");
+  g_assert_cmpuint (info.mnc, ==, 260);
+
+  /* Two digit MNC from an IMSI */
+  g_assert_true (gm_operator_db_lookup (db, "340011234567890", -1, &info));
+  g_assert_cmpstr (info.name, ==, "Orange Caraïbe");
+  g_assert_cmpstr (info.country, ==, "GP");
+  g_assert_cmpuint (info.mnc, ==, 1);
+
+  /* Length limits the digits looked at */
+  g_assert_true (gm_operator_db_lookup (db, "3102609", 6, &info));
+  g_assert_cmpuint (info.mnc, ==, 260);
+  g_assert_false (gm_operator_db_lookup (db, "310260", 5, &info));
+
+  g_assert_false (gm_operator_db_lookup (db, "22803", -1, &info));
+  g_assert_false (gm_operator_db_lookup (db, "2280", -1, &info));
+  g_assert_false (gm_operator_db_lookup (db, "26201", -1, &info));
+  g_assert_false (gm_operator_db_lookup (db, "228a1", -1, &info));
+  g_assert_false (gm_operator_db_lookup (db, "", -1, &info));
+}
+
+
+static void
+test_gm_operator_db_invalid (void)
+{
+  g_autoptr (GmOperatorDb) db = NULL;
+  g_autoptr (GBytes) bytes = NULL;
+  g_autofree char *contents = NULL;
+  GError *err = NULL;
+  gsize len;
+
+  db = gm_operator_db_new_for_path (TEST_DATA_DIR "/doesnotexist", &err);
+  g_assert_error (err, G_FILE_ERROR, G_FILE_ERROR_NOENT);
+  g_assert_null (db);
+  g_clear_error (&err);
+
+  bytes = g_bytes_new_static ("GMOPDB", 6);
+  db = gm_operator_db_new_from_bytes (bytes, &err);
+  g_assert_error (err, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+  g_assert_null (db);
+  g_clear_error (&err);
+  g_clear_pointer (&bytes, g_bytes_unref);
+
+  g_file_get_contents (TEST_OPERATOR_DB, &contents, &len, &err);
+  g_assert_no_error (err);
+
+  /* Truncated */
+  bytes = g_bytes_new (contents, len - 1);
+  db = gm_operator_db_new_from_bytes (bytes, &err);
+  g_assert_error (err, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+  g_assert_null (db);
+  g_clear_error (&err);
+  g_clear_pointer (&bytes, g_bytes_unref);
+
+  /* Child node out of range */
+  contents[24 + 4] = 0x7f;
+  bytes = g_bytes_new (contents, len);
+  db = gm_operator_db_new_from_bytes (bytes, &err);
+  g_assert_error (err, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+  g_assert_null (db);
+  g_clear_error (&err);
+  g_clear_pointer (&bytes, g_bytes_unref);
+
+  /* Unknown version */
+  contents[8] = 2;
+  bytes = g_bytes_new (contents, len);
+  db = gm_operator_db_new_from_bytes (bytes, &err);
+  g_assert_error (err, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED);
+  g_assert_null (db);
+  g_clear_error (&err);
+}
+
+
+static void
+test_gm_operator_db_default (void)
+{
+  g_autoptr (GmOperatorDb) db = NULL;
+  g_autoptr (GmOperatorDb) db2 = NULL;
+  GmOperatorInfo info;
+  GError *err = NULL;
+
+  g_setenv ("GMOBILE_OPERATOR_DB", TEST_OPERATOR_DB, TRUE);
+
+  db = gm_operator_db_get_default (&err);
+  g_assert_no_error (err);
+  g_assert_nonnull (db);
+
+  db2 = gm_operator_db_get_default (&err);
+  g_assert_no_error (err);
+  g_assert_true (db == db2);
+
+  g_assert_true (gm_operator_db_lookup (db, "22801", -1, &info));
+  g_assert_cmpstr (info.name, ==, "Swisscom");
+}
+
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/Gm/operator-db/lookup", test_gm_operator_db_lookup);
+  g_test_add_func ("/Gm/operator-db/invalid", test_gm_operator_db_invalid);
+  g_test_add_func ("/Gm/operator-db/default", test_gm_operator_db_default);
+
+  return g_test_run ();
+}
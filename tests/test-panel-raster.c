@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3-or-later
+ */
+
+#define GMOBILE_USE_UNSTABLE_API
+#include "gmobile.h"
+
+#include "panel-raster.h"
+
+#include "gio/gio.h"
+
+#define GM_DISPLAY_PANEL_RESOURCE_PREFIX "/mobi/phosh/gmobile/devices/display-panels/"
+
+
+static guint
+count_pixels (PanelRaster *raster, guint8 value)
+{
+  guint n = 0;
+
+  for (gsize i = 0; i < (gsize) raster->width * raster->height; i++) {
+    if (raster->pixels[i] == value)
+      n++;
+  }
+
+  return n;
+}
+
+
+static void
+test_gm_panel_raster_path (void)
+{
+  g_autoptr (PanelRaster) raster = panel_raster_new (8, 8);
+  GError *err = NULL;
+  gboolean success;
+
+  g_assert_cmpuint (count_pixels (raster, PANEL_RASTER_OUTSIDE), ==, 64);
+
+  /* Pixel centers on the right and bottom edge are outside */
+  success = panel_raster_fill_path (raster, "M 1,1 h 2 v 2 h -2 Z", 0xff, &err);
+  g_assert_no_error (err);
+  g_assert_true (success);
+  g_assert_cmpuint (count_pixels (raster, 0xff), ==, 4);
+  g_assert_cmpint (raster->pixels[1 * 8 + 1], ==, 0xff);
+  g_assert_cmpint (raster->pixels[2 * 8 + 2], ==, 0xff);
+  g_assert_cmpint (raster->pixels[3 * 8 + 3], ==, PANEL_RASTER_OUTSIDE);
+
+  /* Shapes are clipped, open paths get closed */
+  success = panel_raster_fill_path (raster, "M -4 -4 L 12 -4 L 12 1 L -4 1", 0x80, &err);
+  g_assert_no_error (err);
+  g_assert_true (success);
+  g_assert_cmpuint (count_pixels (raster, 0x80), ==, 8);
+
+  /* A full circle covers all pixels in its interior */
+  success = panel_raster_fill_path (raster, "M 4 1 a 3 3 0 1 0 0.001 0 Z", 0x10, &err);
+  g_assert_no_error (err);
+  g_assert_true (success);
+  g_assert_cmpuint (count_pixels (raster, 0x10), ==, 32);
+
+  success = panel_raster_fill_path (raster, "M 1 1 X 2 2", 0x10, &err);
+  g_assert_error (err, GM_ERROR, GM_ERROR_PARSING_FAILED);
+  g_assert_false (success);
+  g_clear_error (&err);
+
+  success = panel_raster_fill_path (raster, "M 1 1 L 2", 0x10, &err);
+  g_assert_error (err, GM_ERROR, GM_ERROR_PARSING_FAILED);
+  g_assert_false (success);
+  g_clear_error (&err);
+
+  success = panel_raster_fill_path (raster, "1 1", 0x10, &err);
+  g_assert_error (err, GM_ERROR, GM_ERROR_PARSING_FAILED);
+  g_assert_false (success);
+  g_clear_error (&err);
+}
+
+
+static void
+test_gm_panel_raster_rounded_rect (void)
+{
+  g_autoptr (PanelRaster) raster = panel_raster_new (100, 60);
+  const int radii[4] = { 10, 20, 0, 5 };
+
+  panel_raster_fill_rounded_rect (raster, radii, PANEL_RASTER_PANEL);
+
+  g_assert_cmpint (raster->pixels[0], ==, PANEL_RASTER_OUTSIDE);
+  g_assert_cmpint (raster->pixels[99], ==, PANEL_RASTER_OUTSIDE);
+  g_assert_cmpint (raster->pixels[59 * 100 + 99], ==, PANEL_RASTER_PANEL);
+  g_assert_cmpint (raster->pixels[59 * 100], ==, PANEL_RASTER_OUTSIDE);
+  /* The corners' centers are inside */
+  g_assert_cmpint (raster->pixels[10 * 100 + 10], ==, PANEL_RASTER_PANEL);
+  g_assert_cmpint (raster->pixels[20 * 100 + 79], ==, PANEL_RASTER_PANEL);
+  /* Pixels with their center outside the quarter circles */
+  g_assert_cmpuint (count_pixels (raster, PANEL_RASTER_OUTSIDE), ==, 21 + 84 + 5);
+}
+
+
+static void
+test_gm_panel_raster_pgm (void)
+{
+  g_autoptr (PanelRaster) raster = panel_raster_new (3, 2);
+  g_autoptr (GBytes) pgm = NULL;
+  const char *data;
+  gsize len;
+
+  raster->pixels[5] = PANEL_RASTER_CUTOUT;
+  pgm = panel_raster_to_pgm (raster);
+  data = g_bytes_get_data (pgm, &len);
+
+  g_assert_cmpuint (len, ==, strlen ("P5\n3 2\n255\n") + 6);
+  g_assert_true (memcmp (data, "P5\n3 2\n255\n", strlen ("P5\n3 2\n255\n")) == 0);
+  g_assert_cmpint (data[len - 1], ==, PANEL_RASTER_CUTOUT);
+}
+
+
+static GHashTable *
+load_golden (void)
+{
+  g_autoptr (GHashTable) golden = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+  g_autofree char *contents = NULL;
+  g_auto (GStrv) lines = NULL;
+  GError *err = NULL;
+
+  g_file_get_contents (TEST_DATA_DIR "/panel-raster.golden", &contents, NULL, &err);
+  g_assert_no_error (err);
+
+  lines = g_strsplit (contents, "\n", -1);
+  for (int i = 0; lines[i] != NULL; i++) {
+    g_auto (GStrv) fields = NULL;
+
+    if (lines[i][0] == '\0' || lines[i][0] == '#')
+      continue;
+
+    fields = g_strsplit (lines[i], " ", 2);
+    g_assert_cmpint (g_strv_length (fields), ==, 2);
+    g_hash_table_insert (golden, g_strdup (fields[0]), g_strdup (fields[1]));
+  }
+
+  return g_steal_pointer (&golden);
+}
+
+
+static void
+test_gm_panel_raster_golden (void)
+{
+  g_autoptr (GHashTable) golden = load_golden ();
+  g_auto (GStrv) devices = gm_list_devices ();
+  guint n_failed = 0;
+
+  for (int i = 0; devices[i] != NULL; i++) {
+    g_autoptr (GmDisplayPanel) panel = NULL;
+    g_autoptr (PanelRaster) raster = NULL;
+    g_autofree char *resource = NULL;
+    g_autofree char *checksum = NULL;
+    const char *expected;
+    GError *err = NULL;
+
+    resource = g_strconcat (GM_DISPLAY_PANEL_RESOURCE_PREFIX, devices[i], ".json", NULL);
+    panel = gm_display_panel_new_from_resource (resource, &err);
+    g_assert_no_error (err);
+
+    raster = panel_raster_render (panel, &err);
+    g_assert_no_error (err);
+    g_assert_nonnull (raster);
+    g_assert_cmpint (raster->width, ==, gm_display_panel_get_x_res (panel));
+    g_assert_cmpint (raster->height, ==, gm_display_panel_get_y_res (panel));
+
+    checksum = g_compute_checksum_for_data (G_CHECKSUM_SHA256,
+                                            raster->pixels,
+                                            (gsize) raster->width * raster->height);
+    expected = g_hash_table_lookup (golden, devices[i]);
+    if (g_strcmp0 (checksum, expected) != 0) {
+      g_autoptr (GBytes) pgm = panel_raster_to_pgm (raster);
+      g_autofree char *filename = NULL;
+      g_autofree char *path = NULL;
+
+      filename = g_strdup_printf ("%s.pgm", devices[i]);
+      path = g_build_filename (g_get_tmp_dir (), filename, NULL);
+      g_file_set_contents (path, g_bytes_get_data (pgm, NULL), g_bytes_get_size (pgm), NULL);
+      g_test_message ("%s: expected %s, rendered to %s", devices[i], expected ?: "nothing", path);
+      g_test_message ("%s %s", devices[i], checksum);
+      n_failed++;
+    }
+  }
+
+  g_assert_cmpuint (g_hash_table_size (golden), ==, g_strv_length (devices));
+  g_assert_cmpuint (n_failed, ==, 0);
+}
+
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/Gm/panel-raster/path", test_gm_panel_raster_path);
+  g_test_add_func ("/Gm/panel-raster/rounded-rect", test_gm_panel_raster_rounded_rect);
+  g_test_add_func ("/Gm/panel-raster/pgm", test_gm_panel_raster_pgm);
+  g_test_add_func ("/Gm/panel-raster/golden", test_gm_panel_raster_golden);
+
+  return g_test_run ();
+}
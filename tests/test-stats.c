@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3-or-later
+ */
+
+#define GMOBILE_USE_UNSTABLE_API
+#include "gmobile.h"
+
+#include "gio/gio.h"
+
+
+static void
+test_gm_stats_objects (void)
+{
+  g_autoptr (GmCutout) cutout = NULL;
+  GmStats before, stats;
+
+  gm_stats_get (&before);
+
+  cutout = gm_cutout_new ("M 0 0 V 10 H 10 V 0 Z");
+  gm_stats_get (&stats);
+  g_assert_cmpuint (stats.n_cutouts, ==, before.n_cutouts + 1);
+  g_assert_cmpuint (stats.cutouts_size, >, before.cutouts_size);
+  g_assert_cmpuint (stats.n_display_panels, ==, before.n_display_panels);
+
+  g_clear_object (&cutout);
+  gm_stats_get (&stats);
+  g_assert_cmpuint (stats.n_cutouts, ==, before.n_cutouts);
+  g_assert_cmpuint (stats.cutouts_size, ==, before.cutouts_size);
+}
+
+
+static void
+test_gm_stats_trim (void)
+{
+  const char *const unknown[] = { "doesnotexist", NULL };
+  g_autoptr (GmDeviceTreeCompatibles) compatibles = NULL;
+  g_autoptr (GmOperatorDb) db = NULL;
+  g_autoptr (GmDeviceInfo) info = NULL;
+  GmOperatorInfo operator;
+  GError *err = NULL;
+  GmStats stats;
+
+  gm_trim ();
+  gm_stats_get (&stats);
+  g_assert_cmpuint (stats.n_cached_compatibles, ==, 0);
+  g_assert_cmpuint (stats.cached_compatibles_size, ==, 0);
+  g_assert_cmpuint (stats.n_cached_edids, ==, 0);
+  g_assert_cmpuint (stats.cached_edids_size, ==, 0);
+  g_assert_cmpuint (stats.operator_db_size, ==, 0);
+
+  compatibles = gm_device_tree_get_cached_compatibles (TEST_DATA_DIR "/compatibles1", &err);
+  g_assert_no_error (err);
+  g_assert_nonnull (compatibles);
+
+  /* eDP panel with EDID */
+  info = g_object_new (GM_TYPE_DEVICE_INFO,
+                       "compatibles", unknown,
+                       "sysfs-root", TEST_DATA_DIR "/drm2",
+                       NULL);
+  g_assert_nonnull (gm_device_info_get_display_panel (info));
+
+  g_setenv ("GMOBILE_OPERATOR_DB", TEST_OPERATOR_DB, TRUE);
+  db = gm_operator_db_get_default (&err);
+  g_assert_no_error (err);
+  g_assert_nonnull (db);
+
+  gm_stats_get (&stats);
+  g_assert_cmpuint (stats.n_cached_compatibles, ==, 1);
+  g_assert_cmpuint (stats.cached_compatibles_size, >, 0);
+  g_assert_cmpuint (stats.n_cached_edids, ==, 1);
+  g_assert_cmpuint (stats.cached_edids_size, >, 128);
+  g_assert_cmpuint (stats.operator_db_size, >, 0);
+
+  gm_trim ();
+  gm_stats_get (&stats);
+  g_assert_cmpuint (stats.n_cached_compatibles, ==, 0);
+  g_assert_cmpuint (stats.n_cached_edids, ==, 0);
+  g_assert_cmpuint (stats.operator_db_size, ==, 0);
+
+  /* References handed out earlier stay valid */
+  g_assert_cmpstr (gm_device_tree_compatibles_get_strv (compatibles, NULL)[0], ==, "purism,librem5r4");
+  g_assert_true (gm_operator_db_lookup (db, "22801", -1, &operator));
+  g_assert_cmpstr (operator.name, ==, "Swisscom");
+}
+
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/Gm/stats/objects", test_gm_stats_objects);
+  g_test_add_func ("/Gm/stats/trim", test_gm_stats_trim);
+
+  return g_test_run ();
+}
@@ -34,6 +34,7 @@ test_gm_strv_is_null_or_empty (void)
 }
 
 
+#ifdef GM_HAVE_DEVICE_DB
 static void
 test_gm_list_devices (void)
 {
@@ -48,6 +49,57 @@ test_gm_list_devices (void)
 }
 
 
+static void
+test_gm_device_iter (void)
+{
+  g_auto (GStrv) devices = gm_list_devices ();
+  GmDeviceIter iter;
+  const char *name, *last = NULL;
+  guint n = 0;
+
+  /* All devices, sorted */
+  gm_device_iter_init (&iter, NULL);
+  while (gm_device_iter_next (&iter, &name)) {
+    g_assert_cmpstr (name, ==, devices[n]);
+    if (last)
+      g_assert_cmpint (g_strcmp0 (last, name), <, 0);
+    last = name;
+    n++;
+  }
+  g_assert_cmpint (n, ==, g_strv_length (devices));
+  g_assert_false (gm_device_iter_next (&iter, &name));
+
+  /* Empty prefix matches everything */
+  n = 0;
+  gm_device_iter_init (&iter, "");
+  while (gm_device_iter_next (&iter, NULL))
+    n++;
+  g_assert_cmpint (n, ==, g_strv_length (devices));
+
+  /* Prefix */
+  n = 0;
+  gm_device_iter_init (&iter, "fairphone,");
+  while (gm_device_iter_next (&iter, &name)) {
+    g_assert_true (g_str_has_prefix (name, "fairphone,"));
+    n++;
+  }
+  g_assert_cmpint (n, >=, 3);
+
+  /* Exact match */
+  gm_device_iter_init (&iter, "purism,librem5");
+  g_assert_true (gm_device_iter_next (&iter, &name));
+  g_assert_cmpstr (name, ==, "purism,librem5");
+  g_assert_false (gm_device_iter_next (&iter, &name));
+
+  /* No match */
+  gm_device_iter_init (&iter, "doesnotexist,");
+  g_assert_false (gm_device_iter_next (&iter, &name));
+  gm_device_iter_init (&iter, "zzzz");
+  g_assert_false (gm_device_iter_next (&iter, &name));
+}
+#endif
+
+
 gint main (gint argc, gchar *argv[])
 {
   g_test_init (&argc, &argv, NULL);
@@ -56,7 +108,10 @@ gint main (gint argc, gchar *argv[])
 
   g_test_add_func ("/Gm/util/str_null_or_empty", test_gm_str_is_null_or_empty);
   g_test_add_func ("/Gm/util/strv_null_or_empty", test_gm_strv_is_null_or_empty);
+#ifdef GM_HAVE_DEVICE_DB
   g_test_add_func ("/Gm/util/list_devices", test_gm_list_devices);
+  g_test_add_func ("/Gm/util/device_iter", test_gm_device_iter);
+#endif
 
   return g_test_run ();
 }
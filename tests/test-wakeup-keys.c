@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 The Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3-or-later
+ */
+
+#define GMOBILE_USE_UNSTABLE_API
+#include "gmobile.h"
+
+#define KEY_VOLUMEDOWN 114
+#define KEY_VOLUMEUP   115
+#define KEY_POWER      116
+
+
+static void
+test_gm_wakeup_keys_new (void)
+{
+  g_autoptr (GmWakeupKeys) keys = NULL;
+
+  keys = gm_wakeup_keys_new ((const char *[]){ "gmobile:name:gpio-keys:dt:purism,librem5r4", NULL });
+  g_assert_false (gm_wakeup_keys_is_wakeup_key (keys, KEY_VOLUMEDOWN));
+  g_assert_false (gm_wakeup_keys_is_wakeup_key (keys, KEY_VOLUMEUP));
+  g_assert_true (gm_wakeup_keys_is_wakeup_key (keys, KEY_POWER));
+  g_assert_true (gm_wakeup_keys_is_wakeup_key (keys, 0));
+  g_assert_true (gm_wakeup_keys_is_wakeup_key (keys, GM_WAKEUP_KEYS_MAX));
+  g_assert_true (gm_wakeup_keys_is_wakeup_key (keys, GM_WAKEUP_KEYS_MAX + 1));
+  g_clear_pointer (&keys, gm_wakeup_keys_unref);
+
+  /* Default flipped */
+  keys = gm_wakeup_keys_new ((const char *[]){ "gmobile:name:1c21800.lradc:dt:pine64,pinephone-1.2",
+                                               NULL });
+  g_assert_false (gm_wakeup_keys_is_wakeup_key (keys, KEY_VOLUMEDOWN));
+  g_assert_false (gm_wakeup_keys_is_wakeup_key (keys, KEY_POWER));
+  g_assert_false (gm_wakeup_keys_is_wakeup_key (keys, GM_WAKEUP_KEYS_MAX + 1));
+  g_clear_pointer (&keys, gm_wakeup_keys_unref);
+
+  /* No match, all keys wake up */
+  keys = gm_wakeup_keys_new ((const char *[]){ "gmobile:name:gpio-keys:dt:foo,bar", NULL });
+  for (guint i = 0; i <= GM_WAKEUP_KEYS_MAX; i++)
+    g_assert_true (gm_wakeup_keys_is_wakeup_key (keys, i));
+  g_clear_pointer (&keys, gm_wakeup_keys_unref);
+
+  keys = gm_wakeup_keys_new ((const char *[]){ NULL });
+  g_assert_true (gm_wakeup_keys_is_wakeup_key (keys, KEY_VOLUMEUP));
+}
+
+
+static void
+test_gm_wakeup_keys_new_for_input (void)
+{
+  g_autoptr (GmWakeupKeys) keys = NULL;
+
+  /* Device tree */
+  keys = gm_wakeup_keys_new_for_input ("gpio-keys", FALSE, TEST_DATA_DIR "/compatibles1");
+  g_assert_false (gm_wakeup_keys_is_wakeup_key (keys, KEY_VOLUMEUP));
+  g_assert_true (gm_wakeup_keys_is_wakeup_key (keys, KEY_POWER));
+  g_clear_pointer (&keys, gm_wakeup_keys_unref);
+
+  /* AT keyboard matched by DMI data */
+  keys = gm_wakeup_keys_new_for_input ("AT Translated Set 2 keyboard", TRUE, TEST_DATA_DIR "/dmi2");
+  g_assert_false (gm_wakeup_keys_is_wakeup_key (keys, KEY_VOLUMEDOWN));
+  g_assert_false (gm_wakeup_keys_is_wakeup_key (keys, KEY_VOLUMEUP));
+  g_assert_true (gm_wakeup_keys_is_wakeup_key (keys, KEY_POWER));
+  g_clear_pointer (&keys, gm_wakeup_keys_unref);
+
+  /* Not an AT keyboard */
+  keys = gm_wakeup_keys_new_for_input ("AT Translated Set 2 keyboard", FALSE, TEST_DATA_DIR "/dmi2");
+  g_assert_true (gm_wakeup_keys_is_wakeup_key (keys, KEY_VOLUMEUP));
+  g_clear_pointer (&keys, gm_wakeup_keys_unref);
+
+  keys = gm_wakeup_keys_new_for_input ("gpio-keys", FALSE, TEST_DATA_DIR "/doesnotexist");
+  g_assert_true (gm_wakeup_keys_is_wakeup_key (keys, KEY_VOLUMEUP));
+}
+
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/Gm/wakeup-keys/new", test_gm_wakeup_keys_new);
+  g_test_add_func ("/Gm/wakeup-keys/new_for_input", test_gm_wakeup_keys_new_for_input);
+
+  return g_test_run ();
+}